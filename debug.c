@@ -7,6 +7,7 @@
 /* --- Private declarations --- */
 
 static int debug_comp_int(const void * a, const void * b);
+static void debug_profile_write(void);
 
 /* --- Public functions --- */
 
@@ -68,6 +69,33 @@ icemu_debug_t * debug_instance(void) {
     return debug;
 }
 
+icemu_profile_t * debug_profile_instance(const icemu_t * ic) {
+    static icemu_profile_t * profile = NULL;
+
+    /* Initialize singleton profile, sized for the first device that records into it */
+    if (profile == NULL && ic != NULL) {
+        profile = malloc(sizeof(icemu_profile_t));
+
+        profile->file = getenv(DEBUG_PROFILE_ENV);
+
+        if (profile->file != NULL) {
+            profile->node_evals = calloc(ic->nodes_count, sizeof(unsigned long));
+            profile->node_toggles = calloc(ic->nodes_count, sizeof(unsigned long));
+            profile->nodes_count = ic->nodes_count;
+
+            /* Write the profile when the process exits */
+            atexit(debug_profile_write);
+        } else {
+            profile->node_evals = NULL;
+            profile->node_toggles = NULL;
+            profile->nodes_count = 0;
+        }
+    }
+
+    /* Return singleton instance */
+    return profile;
+}
+
 bool_t debug_test_node(nx_t n) {
     nx_t dn;
     icemu_debug_t * debug = debug_instance();
@@ -112,8 +140,43 @@ void debug_print_network(const icemu_t * ic, const char * delim) {
     free(debug_network_nodes);
 }
 
+void debug_profile_node(const icemu_t * ic, nx_t n, bool_t toggled) {
+    icemu_profile_t * profile = debug_profile_instance(ic);
+
+    if (n < profile->nodes_count) {
+        profile->node_evals[n]++;
+
+        if (toggled) {
+            profile->node_toggles[n]++;
+        }
+    }
+}
+
 /* --- Private functions --- */
 
+void debug_profile_write(void) {
+    icemu_profile_t * profile = debug_profile_instance(NULL);
+    FILE * file = fopen(profile->file, "w");
+    nx_t n;
+
+    if (file == NULL) {
+        fprintf(stderr, "[WARNING] Cannot write profile to '%s'\n", profile->file);
+        return;
+    }
+
+    /* List the evaluation and toggle counts of every node that was resolved */
+    fprintf(file, "# node evals toggles\n");
+
+    for (n = 0; n < profile->nodes_count; n++) {
+        if (profile->node_evals[n] > 0) {
+            fprintf(file, "%lu %lu %lu\n", (unsigned long)n, profile->node_evals[n], profile->node_toggles[n]);
+        }
+    }
+
+    fclose(file);
+}
+
+
 int debug_comp_int(const void * a, const void * b) {
     int aa = *(const int *)a;
     int bb = *(const int *)b;
@@ -4,17 +4,28 @@
 #include "icemu.h"
 
 static const char DEBUG_NODES_ENV[] = "DEBUG_NODES";
+static const char DEBUG_PROFILE_ENV[] = "DEBUG_PROFILE";
 
 typedef struct {
     nx_t * debug_nodes;
     size_t debug_nodes_count;
 } icemu_debug_t;
 
+typedef struct {
+    const char * file;
+    unsigned long * node_evals;
+    unsigned long * node_toggles;
+    size_t nodes_count;
+} icemu_profile_t;
+
 icemu_debug_t * debug_instance(void);
+icemu_profile_t * debug_profile_instance(const icemu_t * ic);
 
 bool_t debug_test_node(nx_t n);
 bool_t debug_test_network(const icemu_t * ic);
 
 void debug_print_network(const icemu_t * ic, const char * delim);
 
+void debug_profile_node(const icemu_t * ic, nx_t n, bool_t toggled);
+
 #endif /* INCLUDE_DEBUG_H */
@@ -28,6 +28,7 @@
 
 #include "debug.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -35,6 +36,40 @@
 
 enum { ICEMU_RESOLVE_LIMIT = 50 };
 
+#ifdef DIRTY_BITSET
+
+enum { DIRTY_BITS = sizeof(unsigned long) * CHAR_BIT };
+
+#define DIRTY_WORDS(count)          (((count) + DIRTY_BITS - 1) / DIRTY_BITS)
+#define DIRTY_REF(ic, list, i)      icemu_dirty_ref((ic)->list##_dirty, (i))
+#define DIRTY_MARK(ic, list, i)     ((ic)->list##_dirty[(i) / DIRTY_BITS] |= 1UL << ((i) % DIRTY_BITS))
+#define DIRTY_CLEAR(ic, list, i)    ((ic)->list##_dirty[(i) / DIRTY_BITS] &= ~(1UL << ((i) % DIRTY_BITS)))
+#define DIRTY_TEST(ic, list, i)     (((ic)->list##_dirty[(i) / DIRTY_BITS] >> ((i) % DIRTY_BITS)) & 1UL)
+#define DIRTY_APPLY(ref)            (*(ref).word |= (ref).mask)
+#define DIRTY_RANGE(ic, list, i, start, end)  \
+    for (i = icemu_dirty_next((ic)->list##_dirty, (start), (end)); \
+         i < (end); \
+         i = icemu_dirty_next((ic)->list##_dirty, (i) + 1, (end)))
+
+static dirty_t icemu_dirty_ref(unsigned long * set, size_t i);
+static size_t icemu_dirty_next(const unsigned long * set, size_t i, size_t count);
+
+#else
+
+#define DIRTY_REF(ic, list, i)      (&(ic)->list[i].dirty)
+#define DIRTY_MARK(ic, list, i)     ((ic)->list[i].dirty = true)
+#define DIRTY_CLEAR(ic, list, i)    ((ic)->list[i].dirty = false)
+#define DIRTY_TEST(ic, list, i)     ((ic)->list[i].dirty)
+#define DIRTY_APPLY(ref)            (*(ref) = true)
+#define DIRTY_RANGE(ic, list, i, start, end)  \
+    for (i = (start); i < (end); i++) if ((ic)->list[i].dirty)
+
+#endif
+
+#define DIRTY_FOREACH(ic, list, i)  DIRTY_RANGE(ic, list, i, 0, (ic)->list##_count)
+
+static size_t icemu_dirty_merge(dirty_t * marks, size_t count, dirty_t dirty);
+
 static void icemu_resolve(icemu_t * ic);
 static void icemu_network_reset(icemu_t * ic);
 static void icemu_network_add(icemu_t * ic, nx_t n);
@@ -45,17 +80,50 @@ static void icemu_transistor_resolve(icemu_t * ic, tx_t t);
 static bit_t icemu_transistor_state(icemu_t * ic, tx_t t);
 
 static void icemu_buffer_init(icemu_t * ic, bx_t b, const buffer_t * layout);
-static void icemu_buffer_resolve(icemu_t * ic, bx_t b);
+static void icemu_buffer_resolve(icemu_t * ic, bx_t b, unsigned int iter);
 static bit_t icemu_buffer_output(icemu_t * ic, bx_t b);
 
 static void icemu_function_init(icemu_t * ic, fx_t f, const function_t * layout);
-static void icemu_function_resolve(icemu_t * ic, fx_t f);
+static void icemu_function_resolve(icemu_t * ic, fx_t f, unsigned int iter);
 static bit_t icemu_function_output(icemu_t * ic, fx_t f);
+static bit_t icemu_function_eval(icemu_t * ic, const function_t * function);
+static bit_t icemu_function_call(icemu_t * ic, const function_t * function);
+static function_kind_t icemu_function_kind(const function_t * function);
+
+static void icemu_levels_init(icemu_t * ic);
+static nx_t icemu_level_output(icemu_t * ic, size_t u);
+static bool_t icemu_level_isolated(icemu_t * ic, nx_t n);
+static size_t icemu_level_readers(icemu_t * ic, size_t u, size_t * readers);
 
 static void icemu_cell_init(icemu_t * ic, cx_t c, const cell_t * layout);
 static void icemu_cell_resolve(icemu_t * ic, cx_t c);
 static bit_t icemu_cell_output(icemu_t * ic, cx_t c);
 
+static void icemu_word_init(icemu_t * ic, wx_t w, const word_t * layout);
+static void icemu_word_resolve(icemu_t * ic, wx_t w);
+static bool_t icemu_word_enabled(icemu_t * ic, const nx_t * nodes, size_t count);
+
+static void icemu_pla_init(icemu_t * ic, px_t p, const pla_t * layout);
+static void icemu_pla_resolve(icemu_t * ic, px_t p);
+static unsigned long icemu_pla_word(icemu_t * ic, px_t p);
+
+static void icemu_chain_init(icemu_t * ic, chx_t ch, const chain_t * layout);
+static void icemu_chain_resolve(icemu_t * ic, chx_t ch, unsigned int iter);
+static bool_t icemu_chain_input(icemu_t * ic, chx_t ch, size_t s, size_t i);
+
+static void icemu_pass_init(icemu_t * ic, pgx_t pg, const pass_t * layout);
+static void icemu_pass_resolve(icemu_t * ic, pgx_t pg);
+
+static void icemu_bus_init(icemu_t * ic, bux_t bu, const bus_t * layout);
+static void icemu_bus_resolve(icemu_t * ic, bux_t bu);
+
+static void icemu_clock_init(icemu_t * ic, ckx_t ck, const clock_tree_t * layout);
+static void icemu_clock_resolve(icemu_t * ic, ckx_t ck);
+static bool_t icemu_clock_apply(icemu_t * ic, const clock_output_t * output, bit_t state);
+static void icemu_clock_notify(icemu_t * ic, size_t b);
+static size_t icemu_clock_block(icemu_t * ic, size_t b, dirty_t * marks);
+static size_t icemu_clock_fanout(icemu_t * ic, nx_t n, dirty_t * marks, size_t count);
+
 /* =========== */
 /*    Types    */
 /* =========== */
@@ -82,13 +150,13 @@ char bit_char(bit_t bit) {
 bit_t bit_default(bit_t bit) {
     bit_t map[4] = {BIT_ZERO, BIT_ONE, BIT_ZERO, BIT_ZERO};
 
-    return map[(unsigned char)bit];
+    return map[bit & 3];
 }
 
 bit_t bit_invert(bit_t bit) {
-    bit_t map[4] = {BIT_ONE, BIT_ZERO, BIT_Z, BIT_META};
+    bit_t map[4] = {BIT_ONE, BIT_ZERO, BIT_META, BIT_Z};
 
-    return map[(unsigned char)bit];
+    return map[bit & 3];
 }
 
 level_t bit_level(bit_t bit, logic_t logic) {
@@ -108,7 +176,7 @@ level_t bit_level(bit_t bit, logic_t logic) {
 pull_t bit_pull(bit_t bit) {
     pull_t map[4] = {PULL_DOWN, PULL_UP, PULL_FLOAT, PULL_FLOAT};
 
-    return map[(unsigned char)bit];
+    return map[bit & 3];
 }
 
 /* ============ */
@@ -124,6 +192,14 @@ icemu_t * icemu_init(const icemu_layout_t * layout) {
     bx_t b, bcur;
     fx_t f, fcur;
     cx_t c, ccur;
+    wx_t w, wcur;
+    px_t p, pcur;
+    chx_t ch, chcur;
+    pgx_t pg, pgcur;
+    bux_t bu, bucur;
+    ckx_t ck, ckcur;
+    size_t s;
+    ccx_t k;
 
     icemu_t * ic = malloc(sizeof(icemu_t));
 
@@ -224,6 +300,9 @@ icemu_t * icemu_init(const icemu_layout_t * layout) {
         *(--ic->node_channels[ic->transistors[t].c2]) = t;
     }
 
+    /* Count the enabled channels of each node as transistors switch, so networks only search where they can grow */
+    ic->node_channels_enabled = calloc(ic->nodes_count, sizeof(size_t));
+
     /* --- Buffers --- */
 
     /* Initialize buffer list */
@@ -294,6 +373,11 @@ icemu_t * icemu_init(const icemu_layout_t * layout) {
         }
     }
 
+    /* --- Levels --- */
+
+    /* Order buffers and functions by logic level, so acyclic logic settles in a single iteration */
+    icemu_levels_init(ic);
+
     /* --- Cells --- */
 
     /* Initialize cell list */
@@ -347,11 +431,389 @@ icemu_t * icemu_init(const icemu_layout_t * layout) {
         }
     }
 
+    /* --- Words --- */
+
+    /* Initialize word list */
+    ic->words_count = layout->words_count;
+    ic->words = malloc(sizeof(word_t) * ic->words_count);
+
+    for (w = 0; w < ic->words_count; w++) {
+        icemu_word_init(ic, w, &layout->words[w]);
+    }
+
+    /* Map nodes to word inputs, write enables, and read enables */
+    ic->node_words        = calloc(ic->nodes_count, sizeof(wx_t *));
+    ic->node_words_lists  = calloc(ic->words_count * (WORD_BITS + CELL_WRITES + CELL_READS), sizeof(wx_t));
+    ic->node_words_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (w = 0; w < ic->words_count; w++) {
+        for (n = 0; n < ic->words[w].bits; n++) {
+            ic->node_words_counts[ic->words[w].inputs[n]]++;
+        }
+
+        for (n = 0; n < ic->words[w].writes_count; n++) {
+            ic->node_words_counts[ic->words[w].writes[n]]++;
+        }
+
+        for (n = 0; n < ic->words[w].reads_count; n++) {
+            ic->node_words_counts[ic->words[w].reads[n]]++;
+        }
+    }
+
+    for (n = 0, wcur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_words_counts[n] > 0) {
+            wcur += ic->node_words_counts[n];
+
+            ic->node_words[n] = ic->node_words_lists + wcur;
+        } else {
+            ic->node_words[n] = NULL;
+        }
+    }
+
+    for (w = 0; w < ic->words_count; w++) {
+        for (n = 0; n < ic->words[w].bits; n++) {
+            *(--ic->node_words[ic->words[w].inputs[n]]) = w;
+        }
+
+        for (n = 0; n < ic->words[w].writes_count; n++) {
+            *(--ic->node_words[ic->words[w].writes[n]]) = w;
+        }
+
+        for (n = 0; n < ic->words[w].reads_count; n++) {
+            *(--ic->node_words[ic->words[w].reads[n]]) = w;
+        }
+    }
+
+    /* --- PLAs --- */
+
+    /* Initialize PLA term list */
+    ic->pla_terms_count = layout->pla_terms_count;
+    ic->pla_terms = malloc(sizeof(pla_term_t) * ic->pla_terms_count);
+
+    for (n = 0; n < ic->pla_terms_count; n++) {
+        ic->pla_terms[n] = layout->pla_terms[n];
+    }
+
+    /* Initialize PLA list */
+    ic->plas_count = layout->plas_count;
+    ic->plas = malloc(sizeof(pla_t) * ic->plas_count);
+
+    for (p = 0; p < ic->plas_count; p++) {
+        icemu_pla_init(ic, p, &layout->plas[p]);
+    }
+
+    /* Map nodes to PLA inputs */
+    ic->node_plas        = calloc(ic->nodes_count, sizeof(px_t *));
+    ic->node_plas_lists  = calloc(ic->plas_count * PLA_INPUTS, sizeof(px_t));
+    ic->node_plas_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (p = 0; p < ic->plas_count; p++) {
+        for (n = 0; n < ic->plas[p].inputs_count; n++) {
+            ic->node_plas_counts[ic->plas[p].inputs[n]]++;
+        }
+    }
+
+    for (n = 0, pcur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_plas_counts[n] > 0) {
+            pcur += ic->node_plas_counts[n];
+
+            ic->node_plas[n] = ic->node_plas_lists + pcur;
+        } else {
+            ic->node_plas[n] = NULL;
+        }
+    }
+
+    for (p = 0; p < ic->plas_count; p++) {
+        for (n = 0; n < ic->plas[p].inputs_count; n++) {
+            *(--ic->node_plas[ic->plas[p].inputs[n]]) = p;
+        }
+    }
+
+    /* --- Chains --- */
+
+    /* Initialize chain stage list */
+    ic->chain_stages_count = layout->chain_stages_count;
+    ic->chain_stages = malloc(sizeof(function_t) * ic->chain_stages_count);
+
+    for (s = 0; s < ic->chain_stages_count; s++) {
+        ic->chain_stages[s] = layout->chain_stages[s];
+        ic->chain_stages[s].dirty = false;
+        ic->chain_stages[s].kind = icemu_function_kind(&ic->chain_stages[s]);
+    }
+
+    /* Initialize chain list */
+    ic->chains_count = layout->chains_count;
+    ic->chains = malloc(sizeof(chain_t) * ic->chains_count);
+
+    for (ch = 0; ch < ic->chains_count; ch++) {
+        icemu_chain_init(ic, ch, &layout->chains[ch]);
+    }
+
+    /* Map nodes to chain inputs, leaving out the outputs of earlier stages */
+    ic->node_chains        = calloc(ic->nodes_count, sizeof(chx_t *));
+    ic->node_chains_lists  = calloc(ic->chain_stages_count * FUNCTION_INPUTS, sizeof(chx_t));
+    ic->node_chains_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (ch = 0; ch < ic->chains_count; ch++) {
+        for (s = 0; s < ic->chains[ch].stages_count; s++) {
+            const function_t * stage = &ic->chain_stages[ic->chains[ch].stages_start + s];
+
+            for (n = 0; n < stage->inputs_count; n++) {
+                if (icemu_chain_input(ic, ch, s, n)) {
+                    ic->node_chains_counts[stage->inputs[n]]++;
+                }
+            }
+        }
+    }
+
+    for (n = 0, chcur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_chains_counts[n] > 0) {
+            chcur += ic->node_chains_counts[n];
+
+            ic->node_chains[n] = ic->node_chains_lists + chcur;
+        } else {
+            ic->node_chains[n] = NULL;
+        }
+    }
+
+    for (ch = 0; ch < ic->chains_count; ch++) {
+        for (s = 0; s < ic->chains[ch].stages_count; s++) {
+            const function_t * stage = &ic->chain_stages[ic->chains[ch].stages_start + s];
+
+            for (n = 0; n < stage->inputs_count; n++) {
+                if (icemu_chain_input(ic, ch, s, n)) {
+                    *(--ic->node_chains[stage->inputs[n]]) = ch;
+                }
+            }
+        }
+    }
+
+    /* --- Pass gates --- */
+
+    /* Initialize pass gate list */
+    ic->passes_count = layout->passes_count;
+    ic->passes = malloc(sizeof(pass_t) * ic->passes_count);
+
+    for (pg = 0; pg < ic->passes_count; pg++) {
+        icemu_pass_init(ic, pg, &layout->passes[pg]);
+    }
+
+    /* Map nodes to pass gate inputs */
+    ic->node_passes        = calloc(ic->nodes_count, sizeof(pgx_t *));
+    ic->node_passes_lists  = calloc(ic->passes_count * 2, sizeof(pgx_t));
+    ic->node_passes_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (pg = 0; pg < ic->passes_count; pg++) {
+        ic->node_passes_counts[ic->passes[pg].gate]++;
+        ic->node_passes_counts[ic->passes[pg].input]++;
+    }
+
+    for (n = 0, pgcur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_passes_counts[n] > 0) {
+            pgcur += ic->node_passes_counts[n];
+
+            ic->node_passes[n] = ic->node_passes_lists + pgcur;
+        } else {
+            ic->node_passes[n] = NULL;
+        }
+    }
+
+    for (pg = 0; pg < ic->passes_count; pg++) {
+        *(--ic->node_passes[ic->passes[pg].gate]) = pg;
+        *(--ic->node_passes[ic->passes[pg].input]) = pg;
+    }
+
+    /* --- Precharged buses --- */
+
+    /* Initialize bus list */
+    ic->buses_count = layout->buses_count;
+    ic->buses = malloc(sizeof(bus_t) * ic->buses_count);
+
+    for (bu = 0; bu < ic->buses_count; bu++) {
+        icemu_bus_init(ic, bu, &layout->buses[bu]);
+    }
+
+    /* Map nodes to bus precharge and discharge inputs */
+    ic->node_buses        = calloc(ic->nodes_count, sizeof(bux_t *));
+    ic->node_buses_lists  = calloc(ic->buses_count * (BUS_DISCHARGES + 1), sizeof(bux_t));
+    ic->node_buses_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (bu = 0; bu < ic->buses_count; bu++) {
+        ic->node_buses_counts[ic->buses[bu].precharge]++;
+
+        for (n = 0; n < ic->buses[bu].discharges_count; n++) {
+            ic->node_buses_counts[ic->buses[bu].discharges[n]]++;
+        }
+    }
+
+    for (n = 0, bucur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_buses_counts[n] > 0) {
+            bucur += ic->node_buses_counts[n];
+
+            ic->node_buses[n] = ic->node_buses_lists + bucur;
+        } else {
+            ic->node_buses[n] = NULL;
+        }
+    }
+
+    for (bu = 0; bu < ic->buses_count; bu++) {
+        *(--ic->node_buses[ic->buses[bu].precharge]) = bu;
+
+        for (n = 0; n < ic->buses[bu].discharges_count; n++) {
+            *(--ic->node_buses[ic->buses[bu].discharges[n]]) = bu;
+        }
+    }
+
+    /* --- Clock trees --- */
+
+    /* Initialize clock tree lists */
+    ic->clocks_count = layout->clocks_count;
+    ic->clocks = malloc(sizeof(clock_tree_t) * ic->clocks_count);
+    ic->clock_outputs_count = layout->clock_outputs_count;
+    ic->clock_outputs = malloc(sizeof(clock_output_t) * ic->clock_outputs_count);
+    ic->clock_steps_count = layout->clock_steps_count;
+    ic->clock_steps = malloc(sizeof(clock_step_t) * ic->clock_steps_count);
+    ic->clock_changes_count = layout->clock_changes_count;
+    ic->clock_changes = malloc(sizeof(clock_change_t) * ic->clock_changes_count);
+
+    for (ck = 0; ck < ic->clocks_count; ck++) {
+        icemu_clock_init(ic, ck, &layout->clocks[ck]);
+    }
+
+    for (s = 0; s < ic->clock_outputs_count; s++) {
+        ic->clock_outputs[s] = layout->clock_outputs[s];
+    }
+
+    for (s = 0; s < ic->clock_steps_count; s++) {
+        ic->clock_steps[s] = layout->clock_steps[s];
+    }
+
+    for (s = 0; s < ic->clock_changes_count; s++) {
+        ic->clock_changes[s] = layout->clock_changes[s];
+    }
+
+    /* Map nodes to clock tree inputs */
+    ic->node_clocks        = calloc(ic->nodes_count, sizeof(ckx_t *));
+    ic->node_clocks_lists  = calloc(ic->clocks_count, sizeof(ckx_t));
+    ic->node_clocks_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (ck = 0; ck < ic->clocks_count; ck++) {
+        ic->node_clocks_counts[ic->clocks[ck].input]++;
+    }
+
+    for (n = 0, ckcur = 0; n < ic->nodes_count; n++) {
+        if (ic->node_clocks_counts[n] > 0) {
+            ckcur += ic->node_clocks_counts[n];
+
+            ic->node_clocks[n] = ic->node_clocks_lists + ckcur;
+        } else {
+            ic->node_clocks[n] = NULL;
+        }
+    }
+
+    for (ck = 0; ck < ic->clocks_count; ck++) {
+        *(--ic->node_clocks[ic->clocks[ck].input]) = ck;
+    }
+
+    /* --- Dirty tracking --- */
+
+#ifdef DIRTY_BITSET
+    /* Allocate one bit per item of each type */
+    ic->nodes_dirty       = calloc(DIRTY_WORDS(ic->nodes_count), sizeof(unsigned long));
+    ic->transistors_dirty = calloc(DIRTY_WORDS(ic->transistors_count), sizeof(unsigned long));
+    ic->buffers_dirty     = calloc(DIRTY_WORDS(ic->buffers_count), sizeof(unsigned long));
+    ic->functions_dirty   = calloc(DIRTY_WORDS(ic->functions_count), sizeof(unsigned long));
+    ic->cells_dirty       = calloc(DIRTY_WORDS(ic->cells_count), sizeof(unsigned long));
+    ic->words_dirty       = calloc(DIRTY_WORDS(ic->words_count), sizeof(unsigned long));
+    ic->plas_dirty        = calloc(DIRTY_WORDS(ic->plas_count), sizeof(unsigned long));
+    ic->chains_dirty      = calloc(DIRTY_WORDS(ic->chains_count), sizeof(unsigned long));
+    ic->passes_dirty      = calloc(DIRTY_WORDS(ic->passes_count), sizeof(unsigned long));
+    ic->buses_dirty       = calloc(DIRTY_WORDS(ic->buses_count), sizeof(unsigned long));
+    ic->clocks_dirty      = calloc(DIRTY_WORDS(ic->clocks_count), sizeof(unsigned long));
+
+    /* Map nodes to masks over the transistors they gate, merging gates that share a bitset word */
+    ic->node_gate_masks        = calloc(ic->nodes_count, sizeof(dirty_t *));
+    ic->node_gate_masks_lists  = calloc(ic->transistors_count, sizeof(dirty_t));
+    ic->node_gate_masks_counts = calloc(ic->nodes_count, sizeof(size_t));
+
+    for (n = 0, tcur = 0; n < ic->nodes_count; n++) {
+        ic->node_gate_masks[n] = ic->node_gate_masks_lists + tcur;
+
+        for (t = 0; t < ic->node_gates_counts[n]; t++) {
+            ic->node_gate_masks_counts[n] = icemu_dirty_merge(ic->node_gate_masks[n], ic->node_gate_masks_counts[n],
+                DIRTY_REF(ic, transistors, ic->node_gates[n][t]));
+        }
+
+        tcur += ic->node_gate_masks_counts[n];
+    }
+#endif
+
+    /* Gather the marks for all readers of the outputs changed by each step of a clock edge into one block
+       per step, followed by one block per tree for the readers of all its outputs */
+    for (s = 0, ckcur = 0; s < ic->clock_steps_count + ic->clocks_count; s++) {
+        ckcur += icemu_clock_block(ic, s, NULL);
+    }
+
+    ic->clock_marks  = malloc(sizeof(dirty_t) * ckcur);
+    ic->clock_blocks = malloc(sizeof(size_t) * (ic->clock_steps_count + ic->clocks_count + 1));
+
+    for (s = 0, ckcur = 0; s < ic->clock_steps_count + ic->clocks_count; s++) {
+        ic->clock_blocks[s] = ckcur;
+
+        ckcur += icemu_clock_block(ic, s, ic->clock_marks + ckcur);
+    }
+
+    ic->clock_blocks[s] = ckcur;
+
+    /* --- Channel-connected components --- */
+
+    /* Initialize CCC lists */
+    ic->cccs_count = layout->cccs_count;
+    ic->cccs = malloc(sizeof(ccc_t) * ic->cccs_count);
+    ic->ccc_nodes = malloc(sizeof(nx_t) * layout->ccc_nodes_count);
+    ic->ccc_transistors = malloc(sizeof(tx_t) * layout->ccc_transistors_count);
+
+    for (k = 0; k < ic->cccs_count; k++) {
+        ic->cccs[k] = layout->cccs[k];
+    }
+
+    for (n = 0; n < layout->ccc_nodes_count; n++) {
+        ic->ccc_nodes[n] = layout->ccc_nodes[n];
+    }
+
+    for (t = 0; t < layout->ccc_transistors_count; t++) {
+        ic->ccc_transistors[t] = layout->ccc_transistors[t];
+    }
+
+    /* Map nodes to CCCs, where nodes outside of any CCC map to the CCC count */
+    ic->node_cccs = malloc(sizeof(ccx_t) * ic->nodes_count);
+    ic->ccc_max_nodes = 1;
+
+    for (n = 0; n < ic->nodes_count; n++) {
+        ic->node_cccs[n] = ic->cccs_count;
+    }
+
+    for (k = 0; k < ic->cccs_count; k++) {
+        for (n = 0; n < ic->cccs[k].nodes_count; n++) {
+            ic->node_cccs[ic->ccc_nodes[ic->cccs[k].nodes_start + n]] = k;
+        }
+
+        if (ic->cccs[k].nodes_count > ic->ccc_max_nodes) {
+            ic->ccc_max_nodes = ic->cccs[k].nodes_count;
+        }
+    }
+
+    /* Layouts without a CCC partition may connect any number of nodes */
+    if (layout->cccs == NULL && ic->transistors_count > 0) {
+        ic->ccc_max_nodes = ic->nodes_count;
+    }
+
     /* --- Network --- */
 
-    /* Initialize network state */
-    ic->network_nodes = malloc(sizeof(nx_t) * ic->nodes_count);
+    /* Initialize network state, which can never grow beyond the largest CCC */
+    ic->network_nodes = malloc(sizeof(nx_t) * ic->ccc_max_nodes);
     ic->network_nodes_count = 0;
+    ic->network_members = calloc(ic->nodes_count, sizeof(bool_t));
     ic->network_level_down = LEVEL_FLOAT;
     ic->network_level_up = LEVEL_FLOAT;
 
@@ -371,6 +833,7 @@ void icemu_destroy(icemu_t * ic) {
     free(ic->node_channels);
     free(ic->node_channels_lists);
     free(ic->node_channels_counts);
+    free(ic->node_channels_enabled);
 
     free(ic->node_buffers);
     free(ic->node_buffers_lists);
@@ -384,7 +847,77 @@ void icemu_destroy(icemu_t * ic) {
     free(ic->node_cells_lists);
     free(ic->node_cells_counts);
 
+    free(ic->words);
+
+    free(ic->node_words);
+    free(ic->node_words_lists);
+    free(ic->node_words_counts);
+
+    free(ic->plas);
+    free(ic->pla_terms);
+
+    free(ic->node_plas);
+    free(ic->node_plas_lists);
+    free(ic->node_plas_counts);
+
+    free(ic->chains);
+    free(ic->chain_stages);
+
+    free(ic->node_chains);
+    free(ic->node_chains_lists);
+    free(ic->node_chains_counts);
+
+    free(ic->passes);
+
+    free(ic->node_passes);
+    free(ic->node_passes_lists);
+    free(ic->node_passes_counts);
+
+    free(ic->buses);
+
+    free(ic->node_buses);
+    free(ic->node_buses_lists);
+    free(ic->node_buses_counts);
+
+    free(ic->clocks);
+    free(ic->clock_outputs);
+    free(ic->clock_steps);
+    free(ic->clock_changes);
+    free(ic->clock_marks);
+    free(ic->clock_blocks);
+
+    free(ic->level_buffers);
+    free(ic->level_functions);
+
+    free(ic->node_clocks);
+    free(ic->node_clocks_lists);
+    free(ic->node_clocks_counts);
+
+#ifdef DIRTY_BITSET
+    free(ic->nodes_dirty);
+    free(ic->transistors_dirty);
+    free(ic->buffers_dirty);
+    free(ic->functions_dirty);
+    free(ic->cells_dirty);
+    free(ic->words_dirty);
+    free(ic->plas_dirty);
+    free(ic->chains_dirty);
+    free(ic->passes_dirty);
+    free(ic->buses_dirty);
+    free(ic->clocks_dirty);
+
+    free(ic->node_gate_masks);
+    free(ic->node_gate_masks_lists);
+    free(ic->node_gate_masks_counts);
+#endif
+
+    free(ic->cccs);
+    free(ic->ccc_nodes);
+    free(ic->ccc_transistors);
+    free(ic->node_cccs);
+
     free(ic->network_nodes);
+    free(ic->network_members);
 
     free(ic);
 }
@@ -422,7 +955,7 @@ void icemu_write_node(icemu_t * ic, nx_t n, bit_t state, bool_t sync) {
     }
 
     /* Flag the node as dirty so it will be re-evaluated */
-    ic->nodes[n].dirty = true;
+    DIRTY_MARK(ic, nodes, n);
 
     /* Synchronize the device if requested */
     if (sync) {
@@ -434,60 +967,91 @@ void icemu_write_node(icemu_t * ic, nx_t n, bit_t state, bool_t sync) {
 
 void icemu_resolve(icemu_t * ic) {
     unsigned int i;
+    size_t l;
     nx_t n;
     tx_t t;
     bx_t b;
     fx_t f;
     cx_t c;
+    wx_t w;
+    px_t p;
+    chx_t ch;
+    pgx_t pg;
+    bux_t bu;
+    ckx_t ck;
     bool_t resolved;
 
     for (i = 0; i < ICEMU_RESOLVE_LIMIT; i++) {
 
         /* Iterate through all dirty nodes */
-        for (n = 0; n < ic->nodes_count; n++) {
-            if (ic->nodes[n].dirty) {
+        DIRTY_FOREACH(ic, nodes, n) {
 
-                /* Find the network of all connected nodes */
-                icemu_network_add(ic, n);
+            /* Find the network of all connected nodes */
+            icemu_network_add(ic, n);
 
-                /* Resolve nodes in the network and propagate changes to affected transistors */
-                icemu_network_resolve(ic, i);
+            /* Resolve nodes in the network and propagate changes to affected transistors */
+            icemu_network_resolve(ic, i);
 
-                /* Clean up the network */
-                icemu_network_reset(ic);
-            }
+            /* Clean up the network */
+            icemu_network_reset(ic);
         }
 
         /* Reset resolution flag */
         resolved = true;
 
         /* Resolve dirty components and propagate changes to affected nodes */
-        for (t = 0; t < ic->transistors_count; t++) {
-            if (ic->transistors[t].dirty) {
-                icemu_transistor_resolve(ic, t);
-                resolved = false;
-            }
+        DIRTY_FOREACH(ic, transistors, t) {
+            icemu_transistor_resolve(ic, t);
+            resolved = false;
         }
 
-        for (b = 0; b < ic->buffers_count; b++) {
-            if (ic->buffers[b].dirty) {
-                icemu_buffer_resolve(ic, b);
+        /* Buffers and functions go level by level, so each sees the outputs settled by the levels before it */
+        for (l = 0; l < ic->levels_count; l++) {
+            DIRTY_RANGE(ic, buffers, b, ic->level_buffers[l], ic->level_buffers[l + 1]) {
+                icemu_buffer_resolve(ic, b, i);
                 resolved = false;
             }
-        }
 
-        for (f = 0; f < ic->functions_count; f++) {
-            if (ic->functions[f].dirty) {
-                icemu_function_resolve(ic, f);
+            DIRTY_RANGE(ic, functions, f, ic->level_functions[l], ic->level_functions[l + 1]) {
+                icemu_function_resolve(ic, f, i);
                 resolved = false;
             }
         }
 
-        for (c = 0; c < ic->cells_count; c++) {
-            if (ic->cells[c].dirty) {
-                icemu_cell_resolve(ic, c);
-                resolved = false;
-            }
+        DIRTY_FOREACH(ic, cells, c) {
+            icemu_cell_resolve(ic, c);
+            resolved = false;
+        }
+
+        DIRTY_FOREACH(ic, words, w) {
+            icemu_word_resolve(ic, w);
+            resolved = false;
+        }
+
+        DIRTY_FOREACH(ic, plas, p) {
+            icemu_pla_resolve(ic, p);
+            resolved = false;
+        }
+
+        DIRTY_FOREACH(ic, chains, ch) {
+            icemu_chain_resolve(ic, ch, i);
+            resolved = false;
+        }
+
+        DIRTY_FOREACH(ic, passes, pg) {
+            icemu_pass_resolve(ic, pg);
+            resolved = false;
+        }
+
+        DIRTY_FOREACH(ic, buses, bu) {
+            icemu_bus_resolve(ic, bu);
+            resolved = false;
+        }
+
+        /* Clock trees come last, so each step of an edge is seen by the next iteration */
+        DIRTY_FOREACH(ic, clocks, ck) {
+            icemu_clock_resolve(ic, ck);
+            resolved = false;
         }
 
         /* If no components were marked dirty, resolution is complete */
@@ -501,15 +1065,19 @@ void icemu_resolve(icemu_t * ic) {
 }
 
 void icemu_network_reset(icemu_t * ic) {
+    nx_t nn;
+
+    for (nn = 0; nn < ic->network_nodes_count; nn++) {
+        ic->network_members[ic->network_nodes[nn]] = false;
+    }
+
     ic->network_nodes_count = 0;
     ic->network_level_down = LEVEL_FLOAT;
     ic->network_level_up = LEVEL_FLOAT;
 }
 
 void icemu_network_add(icemu_t * ic, nx_t n) {
-    node_t * node;
     nx_t nn;
-    tx_t c;
 
     /* Stop here if this node is a power rail */
     if (n == ic->off) {
@@ -522,40 +1090,48 @@ void icemu_network_add(icemu_t * ic, nx_t n) {
         return;
     }
 
-    /* Check if this node has already been added to the network */
+    /* Start the network with this node and expand it through the nodes appended after it */
+    ic->network_nodes[ic->network_nodes_count++] = n;
+    ic->network_members[n] = true;
+
     for (nn = 0; nn < ic->network_nodes_count; nn++) {
-        if (ic->network_nodes[nn] == n) {
-            return;
+        nx_t m = ic->network_nodes[nn];
+        node_t * node = &ic->nodes[m];
+        size_t enabled = ic->node_channels_enabled[m];
+        tx_t c;
+
+        /* Update network signal level */
+        if (node->pull == PULL_DOWN && node->level > ic->network_level_down) {
+            ic->network_level_down = node->level;
+        } else if (node->pull == PULL_UP && node->level > ic->network_level_up) {
+            ic->network_level_up = node->level;
+        } else if (node->state == BIT_ZERO && LEVEL_CAP > ic->network_level_down) {
+            ic->network_level_down = LEVEL_CAP;
+        } else if (node->state == BIT_ONE && LEVEL_CAP > ic->network_level_up) {
+            ic->network_level_up = LEVEL_CAP;
         }
-    }
 
-    /* Append this node to the network */
-    ic->network_nodes[ic->network_nodes_count++] = n;
+        /* Search transistor channels connected to this node until all enabled ones are found */
+        for (c = 0; enabled > 0 && c < ic->node_channels_counts[m]; c++) {
+            const transistor_t * transistor = &ic->transistors[ic->node_channels[m][c]];
+            nx_t other;
+
+            if (transistor->state != BIT_ONE) {
+                continue;
+            }
+
+            enabled--;
 
-    /* Update network signal level */
-    node = &ic->nodes[n];
-
-    if (node->pull == PULL_DOWN && node->level > ic->network_level_down) {
-        ic->network_level_down = node->level;
-    } else if (node->pull == PULL_UP && node->level > ic->network_level_up) {
-        ic->network_level_up = node->level;
-    } else if (node->state == BIT_ZERO && LEVEL_CAP > ic->network_level_down) {
-        ic->network_level_down = LEVEL_CAP;
-    } else if (node->state == BIT_ONE && LEVEL_CAP > ic->network_level_up) {
-        ic->network_level_up = LEVEL_CAP;
-    }
-
-    /* Search for transistor channels connected to this node */
-    for (c = 0; c < ic->node_channels_counts[n]; c++) {
-        tx_t t = ic->node_channels[n][c];
-        transistor_t * transistor = &ic->transistors[t];
-
-        /* If the transistor is enabled, recursively expand the network to the other terminal */
-        if (transistor->state == BIT_ONE) {
-            if (transistor->c1 == n) {
-                icemu_network_add(ic, transistor->c2);
-            } else if (transistor->c2 == n) {
-                icemu_network_add(ic, transistor->c1);
+            /* Expand the network to the other terminal, stopping at power rails */
+            other = transistor->c1 == m ? transistor->c2 : transistor->c1;
+
+            if (other == ic->off) {
+                ic->network_level_down = LEVEL_POWER;
+            } else if (other == ic->on) {
+                ic->network_level_up = LEVEL_POWER;
+            } else if (!ic->network_members[other]) {
+                ic->network_nodes[ic->network_nodes_count++] = other;
+                ic->network_members[other] = true;
             }
         }
     }
@@ -585,29 +1161,69 @@ void icemu_network_resolve(icemu_t * ic, unsigned int iter) {
         bx_t b;
         fx_t f;
         cx_t c;
+        wx_t w;
+        px_t p;
+        chx_t ch;
+        pgx_t pg;
+        bux_t bu;
+        ckx_t ck;
 
         /* Update dirty flags for affected components if the state changed */
         if (state != ic->nodes[n].state) {
+#ifdef DIRTY_BITSET
+            for (t = 0; t < ic->node_gate_masks_counts[n]; t++) {
+                DIRTY_APPLY(ic->node_gate_masks[n][t]);
+            }
+#else
             for (t = 0; t < ic->node_gates_counts[n]; t++) {
-                ic->transistors[ic->node_gates[n][t]].dirty = true;
+                DIRTY_MARK(ic, transistors, ic->node_gates[n][t]);
             }
+#endif
 
             for (b = 0; b < ic->node_buffers_counts[n]; b++) {
-                ic->buffers[ic->node_buffers[n][b]].dirty = true;
+                DIRTY_MARK(ic, buffers, ic->node_buffers[n][b]);
             }
 
             for (f = 0; f < ic->node_functions_counts[n]; f++) {
-                ic->functions[ic->node_functions[n][f]].dirty = true;
+                DIRTY_MARK(ic, functions, ic->node_functions[n][f]);
             }
 
             for (c = 0; c < ic->node_cells_counts[n]; c++) {
-                ic->cells[ic->node_cells[n][c]].dirty = true;
+                DIRTY_MARK(ic, cells, ic->node_cells[n][c]);
+            }
+
+            for (w = 0; w < ic->node_words_counts[n]; w++) {
+                DIRTY_MARK(ic, words, ic->node_words[n][w]);
+            }
+
+            for (p = 0; p < ic->node_plas_counts[n]; p++) {
+                DIRTY_MARK(ic, plas, ic->node_plas[n][p]);
+            }
+
+            for (ch = 0; ch < ic->node_chains_counts[n]; ch++) {
+                DIRTY_MARK(ic, chains, ic->node_chains[n][ch]);
+            }
+
+            for (pg = 0; pg < ic->node_passes_counts[n]; pg++) {
+                DIRTY_MARK(ic, passes, ic->node_passes[n][pg]);
+            }
+
+            for (bu = 0; bu < ic->node_buses_counts[n]; bu++) {
+                DIRTY_MARK(ic, buses, ic->node_buses[n][bu]);
+            }
+
+            for (ck = 0; ck < ic->node_clocks_counts[n]; ck++) {
+                DIRTY_MARK(ic, clocks, ic->node_clocks[n][ck]);
             }
         }
 
+#ifdef PROFILE
+        debug_profile_node(ic, n, state != ic->nodes[n].state);
+#endif
+
         /* Update node states and clear dirty flags */
         ic->nodes[n].state = state;
-        ic->nodes[n].dirty = false;
+        DIRTY_CLEAR(ic, nodes, n);
     }
 
 #ifdef DEBUG
@@ -625,7 +1241,7 @@ void icemu_network_resolve(icemu_t * ic, unsigned int iter) {
             tx_t g;
 
             for (g = 0; g < ic->node_gates_counts[n]; g++) {
-                if (ic->transistors[ic->node_gates[n][g]].dirty) {
+                if (DIRTY_TEST(ic, transistors, ic->node_gates[n][g])) {
                     dirty = true;
                     break;
                 }
@@ -696,13 +1312,23 @@ void icemu_transistor_resolve(icemu_t * ic, tx_t t) {
 
     /* Update dirty flags for affected nodes if the state changed */
     if (state != transistor->state) {
-        ic->nodes[transistor->c1].dirty = true;
-        ic->nodes[transistor->c2].dirty = true;
+        if (transistor->c1 != transistor->c2) {
+            if (state == BIT_ONE) {
+                ic->node_channels_enabled[transistor->c1]++;
+                ic->node_channels_enabled[transistor->c2]++;
+            } else if (transistor->state == BIT_ONE) {
+                ic->node_channels_enabled[transistor->c1]--;
+                ic->node_channels_enabled[transistor->c2]--;
+            }
+        }
+
+        DIRTY_MARK(ic, nodes, transistor->c1);
+        DIRTY_MARK(ic, nodes, transistor->c2);
     }
 
     /* Update transistor state and clear dirty flag */
     transistor->state = state;
-    transistor->dirty = false;
+    DIRTY_CLEAR(ic, transistors, t);
 }
 
 bit_t icemu_transistor_state(icemu_t * ic, tx_t t) {
@@ -735,6 +1361,7 @@ void icemu_buffer_init(icemu_t * ic, bx_t b, const buffer_t * layout) {
     buffer->input     = layout->input;
     buffer->output    = layout->output;
     buffer->dirty     = false;
+    buffer->immediate = false;
 
     /* Calculate default output */
     output = icemu_buffer_output(ic, b);
@@ -744,19 +1371,27 @@ void icemu_buffer_init(icemu_t * ic, bx_t b, const buffer_t * layout) {
     ic->nodes[buffer->output].pull = bit_pull(output);
 }
 
-void icemu_buffer_resolve(icemu_t * ic, bx_t b) {
+void icemu_buffer_resolve(icemu_t * ic, bx_t b, unsigned int iter) {
     buffer_t * buffer = &ic->buffers[b];
 
     /* Calculate output value */
     bit_t output = icemu_buffer_output(ic, b);
 
-    /* Apply load and set dirty flag on output node */
+    /* Apply load to output node */
     ic->nodes[buffer->output].level = bit_level(output, buffer->logic);
     ic->nodes[buffer->output].pull = bit_pull(output);
-    ic->nodes[buffer->output].dirty = true;
+
+    /* Settle the output node now if it only feeds later levels, otherwise leave it to the next iteration */
+    if (buffer->immediate) {
+        icemu_network_add(ic, buffer->output);
+        icemu_network_resolve(ic, iter);
+        icemu_network_reset(ic);
+    } else {
+        DIRTY_MARK(ic, nodes, buffer->output);
+    }
 
     /* Clear buffer dirty flag */
-    buffer->dirty = false;
+    DIRTY_CLEAR(ic, buffers, b);
 }
 
 bit_t icemu_buffer_output(icemu_t * ic, bx_t b) {
@@ -785,11 +1420,15 @@ void icemu_function_init(icemu_t * ic, fx_t f, const function_t * layout) {
     function->inputs_count = layout->inputs_count;
     function->output       = layout->output;
     function->dirty        = false;
+    function->immediate    = false;
 
     for (n = 0; n < function->inputs_count; n++) {
         function->inputs[n] = layout->inputs[n];
     }
 
+    /* Recognize functions that can be evaluated without calling them */
+    function->kind = icemu_function_kind(function);
+
     /* Calculate default output */
     output = icemu_function_output(ic, f);
 
@@ -798,23 +1437,63 @@ void icemu_function_init(icemu_t * ic, fx_t f, const function_t * layout) {
     ic->nodes[function->output].pull = bit_pull(output);
 }
 
-void icemu_function_resolve(icemu_t * ic, fx_t f) {
+void icemu_function_resolve(icemu_t * ic, fx_t f, unsigned int iter) {
     function_t * function = &ic->functions[f];
 
     /* Calculate output value */
     bit_t output = icemu_function_output(ic, f);
 
-    /* Apply load and set dirty flag on output node */
+    /* Apply load to output node */
     ic->nodes[function->output].level = bit_level(output, function->logic);
     ic->nodes[function->output].pull = bit_pull(output);
-    ic->nodes[function->output].dirty = true;
+
+    /* Settle the output node now if it only feeds later levels, otherwise leave it to the next iteration */
+    if (function->immediate) {
+        icemu_network_add(ic, function->output);
+        icemu_network_resolve(ic, iter);
+        icemu_network_reset(ic);
+    } else {
+        DIRTY_MARK(ic, nodes, function->output);
+    }
 
     /* Clear function dirty flag */
-    function->dirty = false;
+    DIRTY_CLEAR(ic, functions, f);
 }
 
 bit_t icemu_function_output(icemu_t * ic, fx_t f) {
-    function_t * function = &ic->functions[f];
+    return icemu_function_eval(ic, &ic->functions[f]);
+}
+
+bit_t icemu_function_eval(icemu_t * ic, const function_t * function) {
+    size_t count = function->inputs_count;
+    size_t n;
+
+    /* NOR and NAND only need to find one input that decides the output */
+    switch (function->kind) {
+        case FUNCTION_NOR:
+            for (n = 0; n < count; n++) {
+                if (ic->nodes[function->inputs[n]].state == BIT_ONE) {
+                    return BIT_ZERO;
+                }
+            }
+
+            return BIT_ONE;
+        case FUNCTION_NAND:
+            for (n = 0; n < count; n++) {
+                if (ic->nodes[function->inputs[n]].state != BIT_ONE) {
+                    return BIT_ONE;
+                }
+            }
+
+            return BIT_ZERO;
+        case FUNCTION_CUSTOM:
+            break;
+    }
+
+    return icemu_function_call(ic, function);
+}
+
+bit_t icemu_function_call(icemu_t * ic, const function_t * function) {
     size_t count = function->inputs_count;
 
     /* Fetch function arguments from input nodes */
@@ -831,6 +1510,227 @@ bit_t icemu_function_output(icemu_t * ic, fx_t f) {
     return function->func(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9);
 }
 
+function_kind_t icemu_function_kind(const function_t * function) {
+    size_t count = function->inputs_count;
+    bit_t args[FUNCTION_INPUTS];
+    bool_t nor = true, nand = true;
+    unsigned long word, all;
+    size_t n;
+
+    if (count == 0) {
+        return FUNCTION_CUSTOM;
+    }
+
+    all = (1UL << count) - 1;
+
+    /* Compare the truth table against NOR and NAND over the inputs in use, with the rest held low */
+    for (word = 0; word <= all && (nor || nand); word++) {
+        bit_t output;
+
+        for (n = 0; n < FUNCTION_INPUTS; n++) {
+            args[n] = n < count && (word >> n) & 1UL ? BIT_ONE : BIT_ZERO;
+        }
+
+        output = function->func(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]);
+
+        if (output != (word == 0 ? BIT_ONE : BIT_ZERO)) {
+            nor = false;
+        }
+
+        if (output != (word == all ? BIT_ZERO : BIT_ONE)) {
+            nand = false;
+        }
+    }
+
+    if (nor) {
+        return FUNCTION_NOR;
+    }
+
+    return nand ? FUNCTION_NAND : FUNCTION_CUSTOM;
+}
+
+/* ============ */
+/*    Levels    */
+/* ============ */
+
+/* --- Private functions  --- */
+
+void icemu_levels_init(icemu_t * ic) {
+    size_t count = ic->buffers_count + ic->functions_count;
+    size_t * inputs = calloc(count, sizeof(size_t));
+    size_t * levels = calloc(count, sizeof(size_t));
+    size_t * queue = malloc(sizeof(size_t) * count);
+    size_t * positions = malloc(sizeof(size_t) * count);
+    size_t * readers = malloc(sizeof(size_t) * (ic->buffers_count + ic->functions_count * FUNCTION_INPUTS));
+    size_t head = 0, tail = 0, leftover = 0;
+    buffer_t * buffers;
+    function_t * functions;
+    size_t u, k, l, r;
+    nx_t n;
+
+    /* Components whose output is read by later levels, counted once per reading input */
+    for (u = 0; u < count; u++) {
+        r = icemu_level_readers(ic, u, readers);
+
+        for (k = 0; k < r; k++) {
+            inputs[readers[k]]++;
+        }
+    }
+
+    /* Take components in topological order, each one level past the deepest component it reads */
+    for (u = 0; u < count; u++) {
+        if (inputs[u] == 0) {
+            queue[tail++] = u;
+        }
+    }
+
+    ic->levels_count = 0;
+
+    while (head < tail) {
+        u = queue[head++];
+        r = icemu_level_readers(ic, u, readers);
+
+        if (levels[u] + 1 > ic->levels_count) {
+            ic->levels_count = levels[u] + 1;
+        }
+
+        for (k = 0; k < r; k++) {
+            if (levels[readers[k]] < levels[u] + 1) {
+                levels[readers[k]] = levels[u] + 1;
+            }
+
+            if (--inputs[readers[k]] == 0) {
+                queue[tail++] = readers[k];
+            }
+        }
+    }
+
+    /* Feedback loops and the logic behind them never run out of inputs, so they go last and settle over iterations */
+    for (u = 0; u < count; u++) {
+        if (inputs[u] > 0) {
+            levels[u] = ic->levels_count;
+            leftover++;
+        }
+    }
+
+    if (leftover > 0) {
+        ic->levels_count++;
+    }
+
+    /* Find where each level starts in the buffer and function lists */
+    ic->level_buffers = calloc(ic->levels_count + 1, sizeof(size_t));
+    ic->level_functions = calloc(ic->levels_count + 1, sizeof(size_t));
+
+    for (u = 0; u < count; u++) {
+        if (u < ic->buffers_count) {
+            ic->level_buffers[levels[u] + 1]++;
+        } else {
+            ic->level_functions[levels[u] + 1]++;
+        }
+    }
+
+    for (l = 0; l < ic->levels_count; l++) {
+        ic->level_buffers[l + 1] += ic->level_buffers[l];
+        ic->level_functions[l + 1] += ic->level_functions[l];
+    }
+
+    /* Place components in level order, keeping the layout order within each level */
+    for (u = 0; u < count; u++) {
+        if (u < ic->buffers_count) {
+            positions[u] = ic->level_buffers[levels[u]]++;
+        } else {
+            positions[u] = ic->level_functions[levels[u]]++;
+        }
+    }
+
+    for (l = ic->levels_count; l > 0; l--) {
+        ic->level_buffers[l] = ic->level_buffers[l - 1];
+        ic->level_functions[l] = ic->level_functions[l - 1];
+    }
+
+    ic->level_buffers[0] = 0;
+    ic->level_functions[0] = 0;
+
+    /* Mark components that can settle their output within the iteration that resolves them */
+    for (u = 0; u < count; u++) {
+        bool_t immediate = inputs[u] == 0 && icemu_level_isolated(ic, icemu_level_output(ic, u));
+
+        if (u < ic->buffers_count) {
+            ic->buffers[u].immediate = immediate;
+        } else {
+            ic->functions[u - ic->buffers_count].immediate = immediate;
+        }
+    }
+
+    /* Reorder the component lists and the node maps that refer to them */
+    buffers = malloc(sizeof(buffer_t) * ic->buffers_count);
+    functions = malloc(sizeof(function_t) * ic->functions_count);
+
+    for (u = 0; u < count; u++) {
+        if (u < ic->buffers_count) {
+            buffers[positions[u]] = ic->buffers[u];
+        } else {
+            functions[positions[u]] = ic->functions[u - ic->buffers_count];
+        }
+    }
+
+    free(ic->buffers);
+    free(ic->functions);
+
+    ic->buffers = buffers;
+    ic->functions = functions;
+
+    for (n = 0; n < ic->nodes_count; n++) {
+        for (k = 0; k < ic->node_buffers_counts[n]; k++) {
+            ic->node_buffers[n][k] = positions[ic->node_buffers[n][k]];
+        }
+
+        for (k = 0; k < ic->node_functions_counts[n]; k++) {
+            ic->node_functions[n][k] = positions[ic->buffers_count + ic->node_functions[n][k]];
+        }
+    }
+
+    free(inputs);
+    free(levels);
+    free(queue);
+    free(positions);
+    free(readers);
+}
+
+nx_t icemu_level_output(icemu_t * ic, size_t u) {
+    if (u < ic->buffers_count) {
+        return ic->buffers[u].output;
+    } else {
+        return ic->functions[u - ic->buffers_count].output;
+    }
+}
+
+bool_t icemu_level_isolated(icemu_t * ic, nx_t n) {
+    /* Outputs shared with transistor channels or rails resolve as networks, in the next iteration */
+    return ic->node_channels_counts[n] == 0 && n != ic->on && n != ic->off;
+}
+
+size_t icemu_level_readers(icemu_t * ic, size_t u, size_t * readers) {
+    nx_t n = icemu_level_output(ic, u);
+    size_t count = 0;
+    size_t k;
+
+    if (!icemu_level_isolated(ic, n)) {
+        return 0;
+    }
+
+    /* List buffers and functions that read the output, numbering functions after buffers */
+    for (k = 0; k < ic->node_buffers_counts[n]; k++) {
+        readers[count++] = ic->node_buffers[n][k];
+    }
+
+    for (k = 0; k < ic->node_functions_counts[n]; k++) {
+        readers[count++] = ic->buffers_count + ic->node_functions[n][k];
+    }
+
+    return count;
+}
+
 /* ========== */
 /*    Cell    */
 /* ========== */
@@ -889,18 +1789,18 @@ void icemu_cell_resolve(icemu_t * ic, cx_t c) {
     if (cell->outputs_count > 0) {
         ic->nodes[cell->outputs[0]].level = bit_level(output, cell->logic);
         ic->nodes[cell->outputs[0]].pull = bit_pull(output);
-        ic->nodes[cell->outputs[0]].dirty = true;
+        DIRTY_MARK(ic, nodes, cell->outputs[0]);
     }
 
     /* Apply load and set dirty flag on inverting output node */
     if (cell->outputs_count > 1) {
         ic->nodes[cell->outputs[1]].level = bit_level(bit_invert(output), cell->logic);
         ic->nodes[cell->outputs[1]].pull = bit_pull(bit_invert(output));
-        ic->nodes[cell->outputs[1]].dirty = true;
+        DIRTY_MARK(ic, nodes, cell->outputs[1]);
     }
 
     /* Clear cell dirty flag */
-    cell->dirty = false;
+    DIRTY_CLEAR(ic, cells, c);
 }
 
 bit_t icemu_cell_output(icemu_t * ic, cx_t c) {
@@ -942,3 +1842,588 @@ bit_t icemu_cell_output(icemu_t * ic, cx_t c) {
 
     return BIT_Z;
 }
+
+/* ========== */
+/*    Word    */
+/* ========== */
+
+void icemu_word_init(icemu_t * ic, wx_t w, const word_t * layout) {
+    word_t * word = &ic->words[w];
+    nx_t n;
+
+    /* Initialize word properties */
+    word->logic        = layout->logic;
+    word->type         = layout->type;
+    word->bits         = layout->bits;
+    word->writes_count = layout->writes_count;
+    word->reads_count  = layout->reads_count;
+    word->state        = 0;
+    word->latched      = false;
+    word->output       = 0;
+    word->driven       = false;
+    word->emitted      = false;
+    word->dirty        = false;
+
+    for (n = 0; n < word->bits; n++) {
+        word->inputs[n] = layout->inputs[n];
+        word->outputs[n] = layout->outputs[n];
+    }
+
+    for (n = 0; n < word->writes_count; n++) {
+        word->writes[n] = layout->writes[n];
+    }
+
+    for (n = 0; n < word->reads_count; n++) {
+        word->reads[n] = layout->reads[n];
+    }
+
+    /* Apply initial load to output nodes, which float until the word is first latched */
+    for (n = 0; n < word->bits; n++) {
+        ic->nodes[word->outputs[n]].level = bit_level(BIT_Z, word->logic);
+        ic->nodes[word->outputs[n]].pull = bit_pull(BIT_Z);
+    }
+}
+
+void icemu_word_resolve(icemu_t * ic, wx_t w) {
+    word_t * word = &ic->words[w];
+    unsigned int changed;
+    bool_t driven;
+    nx_t n;
+
+    /* Latch all inputs at once if writing is enabled */
+    if (icemu_word_enabled(ic, word->writes, word->writes_count)) {
+        switch (word->type) {
+            case CELL_D_LATCH:
+                word->state = 0;
+
+                for (n = 0; n < word->bits; n++) {
+                    if (bit_default(ic->nodes[word->inputs[n]].state)) {
+                        word->state |= 1U << n;
+                    }
+                }
+
+                word->latched = true;
+                break;
+        }
+    }
+
+    /* Outputs are driven once the word is latched and reading is enabled */
+    driven = word->latched && icemu_word_enabled(ic, word->reads, word->reads_count);
+
+    /* Find output bits that changed since they were last applied */
+    if (!word->emitted || driven != word->driven) {
+        changed = ~0U;
+    } else {
+        changed = driven ? word->state ^ word->output : 0;
+    }
+
+    word->driven = driven;
+    word->emitted = true;
+
+    /* Apply load and set dirty flag on changed output nodes */
+    for (n = 0; changed && n < word->bits; n++) {
+        if (changed & (1U << n)) {
+            bit_t output = word->driven ? (bit_t)((word->state >> n) & 1U) : BIT_Z;
+
+            ic->nodes[word->outputs[n]].level = bit_level(output, word->logic);
+            ic->nodes[word->outputs[n]].pull = bit_pull(output);
+            DIRTY_MARK(ic, nodes, word->outputs[n]);
+        }
+    }
+
+    word->output = word->state;
+
+    /* Clear word dirty flag */
+    DIRTY_CLEAR(ic, words, w);
+}
+
+bool_t icemu_word_enabled(icemu_t * ic, const nx_t * nodes, size_t count) {
+    nx_t n;
+
+    /* Check that every enable node is high */
+    for (n = 0; n < count; n++) {
+        if (!bit_default(ic->nodes[nodes[n]].state)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* ========= */
+/*    PLA    */
+/* ========= */
+
+void icemu_pla_init(icemu_t * ic, px_t p, const pla_t * layout) {
+    pla_t * pla = &ic->plas[p];
+    unsigned long word;
+    size_t k;
+    nx_t n;
+
+    /* Initialize PLA properties */
+    pla->logic        = layout->logic;
+    pla->inputs_count = layout->inputs_count;
+    pla->terms_start  = layout->terms_start;
+    pla->terms_count  = layout->terms_count;
+    pla->dirty        = false;
+
+    for (n = 0; n < pla->inputs_count; n++) {
+        pla->inputs[n] = layout->inputs[n];
+    }
+
+    /* Calculate default outputs */
+    word = icemu_pla_word(ic, p);
+
+    for (k = pla->terms_start; k < pla->terms_start + pla->terms_count; k++) {
+        pla_term_t * term = &ic->pla_terms[k];
+        bit_t output = (word & term->mask) ? BIT_ZERO : BIT_ONE;
+
+        /* Apply initial load to output node, leaving the term unresolved until first evaluated */
+        ic->nodes[term->output].level = bit_level(output, pla->logic);
+        ic->nodes[term->output].pull = bit_pull(output);
+
+        term->state = BIT_Z;
+    }
+}
+
+void icemu_pla_resolve(icemu_t * ic, px_t p) {
+    pla_t * pla = &ic->plas[p];
+    size_t k;
+
+    /* Match every term against the packed input word at once */
+    unsigned long word = icemu_pla_word(ic, p);
+
+    for (k = pla->terms_start; k < pla->terms_start + pla->terms_count; k++) {
+        pla_term_t * term = &ic->pla_terms[k];
+        bit_t output = (word & term->mask) ? BIT_ZERO : BIT_ONE;
+
+        /* Apply load and set dirty flag on output nodes whose term changed */
+        if (output != term->state) {
+            ic->nodes[term->output].level = bit_level(output, pla->logic);
+            ic->nodes[term->output].pull = bit_pull(output);
+            DIRTY_MARK(ic, nodes, term->output);
+
+            term->state = output;
+        }
+    }
+
+    /* Clear PLA dirty flag */
+    DIRTY_CLEAR(ic, plas, p);
+}
+
+unsigned long icemu_pla_word(icemu_t * ic, px_t p) {
+    pla_t * pla = &ic->plas[p];
+    unsigned long word = 0;
+    nx_t n;
+
+    /* Pack input node states into one bit per input */
+    for (n = 0; n < pla->inputs_count; n++) {
+        if (bit_default(ic->nodes[pla->inputs[n]].state)) {
+            word |= 1UL << n;
+        }
+    }
+
+    return word;
+}
+
+/* =========== */
+/*    Chain    */
+/* =========== */
+
+void icemu_chain_init(icemu_t * ic, chx_t ch, const chain_t * layout) {
+    chain_t * chain = &ic->chains[ch];
+    size_t s;
+
+    /* Initialize chain properties */
+    chain->stages_start = layout->stages_start;
+    chain->stages_count = layout->stages_count;
+    chain->dirty        = false;
+
+    for (s = chain->stages_start; s < chain->stages_start + chain->stages_count; s++) {
+        const function_t * stage = &ic->chain_stages[s];
+
+        /* Apply initial load to each stage output */
+        bit_t output = icemu_function_eval(ic, stage);
+
+        ic->nodes[stage->output].level = bit_level(output, stage->logic);
+        ic->nodes[stage->output].pull = bit_pull(output);
+    }
+}
+
+void icemu_chain_resolve(icemu_t * ic, chx_t ch, unsigned int iter) {
+    chain_t * chain = &ic->chains[ch];
+    size_t s;
+
+    for (s = chain->stages_start; s < chain->stages_start + chain->stages_count; s++) {
+        const function_t * stage = &ic->chain_stages[s];
+
+        /* Calculate output value */
+        bit_t output = icemu_function_eval(ic, stage);
+
+        /* Apply load to output node */
+        ic->nodes[stage->output].level = bit_level(output, stage->logic);
+        ic->nodes[stage->output].pull = bit_pull(output);
+
+        /* Resolve the output node right away, so the next stage sees it in this iteration */
+        icemu_network_add(ic, stage->output);
+        icemu_network_resolve(ic, iter);
+        icemu_network_reset(ic);
+    }
+
+    /* Clear chain dirty flag */
+    DIRTY_CLEAR(ic, chains, ch);
+}
+
+bool_t icemu_chain_input(icemu_t * ic, chx_t ch, size_t s, size_t i) {
+    const chain_t * chain = &ic->chains[ch];
+    const function_t * stage = &ic->chain_stages[chain->stages_start + s];
+    nx_t input = stage->inputs[i];
+    size_t ss, ii;
+
+    /* Inputs driven by an earlier stage are resolved within the chain */
+    for (ss = 0; ss < s; ss++) {
+        if (ic->chain_stages[chain->stages_start + ss].output == input) {
+            return false;
+        }
+    }
+
+    /* Only count each input node once per chain */
+    for (ss = 0; ss <= s; ss++) {
+        const function_t * prev = &ic->chain_stages[chain->stages_start + ss];
+
+        for (ii = 0; ii < (ss == s ? i : prev->inputs_count); ii++) {
+            if (prev->inputs[ii] == input) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* =============== */
+/*    Pass gate    */
+/* =============== */
+
+/* --- Private functions  --- */
+
+void icemu_pass_init(icemu_t * ic, pgx_t pg, const pass_t * layout) {
+    pass_t * pass = &ic->passes[pg];
+
+    /* Initialize pass gate properties */
+    pass->type   = layout->type;
+    pass->gate   = layout->gate;
+    pass->input  = layout->input;
+    pass->output = layout->output;
+    pass->dirty  = false;
+}
+
+void icemu_pass_resolve(icemu_t * ic, pgx_t pg) {
+    pass_t * pass = &ic->passes[pg];
+    bit_t gate = ic->nodes[pass->gate].state;
+    bit_t input = ic->nodes[pass->input].state;
+    bool_t closed = pass->type == TRANSISTOR_NMOS ? gate == BIT_ONE : gate == BIT_ZERO;
+
+    /* An input that has not been resolved yet, as at power-on, still carries the level of its driver. The
+       transistor would have resolved it along with the output, so resolve it and wait for it to change. */
+    if (closed && input == BIT_Z) {
+        DIRTY_MARK(ic, nodes, pass->input);
+    }
+
+    if (closed && input != BIT_Z) {
+        /* Apply load and set dirty flag on output node, pulling it down from a metastable input as logic reads it */
+        ic->nodes[pass->output].level = LEVEL_LOAD;
+        ic->nodes[pass->output].pull = input == BIT_ONE ? PULL_UP : PULL_DOWN;
+        DIRTY_MARK(ic, nodes, pass->output);
+    } else {
+        /* Leave the output holding its charge */
+        ic->nodes[pass->output].level = LEVEL_FLOAT;
+        ic->nodes[pass->output].pull = PULL_FLOAT;
+    }
+
+    /* Clear pass gate dirty flag */
+    DIRTY_CLEAR(ic, passes, pg);
+}
+
+/* ==================== */
+/*    Precharged bus    */
+/* ==================== */
+
+/* --- Private functions  --- */
+
+void icemu_bus_init(icemu_t * ic, bux_t bu, const bus_t * layout) {
+    bus_t * bus = &ic->buses[bu];
+    size_t n;
+
+    /* Initialize bus properties */
+    bus->type             = layout->type;
+    bus->precharge        = layout->precharge;
+    bus->discharges_count = layout->discharges_count;
+    bus->output           = layout->output;
+    bus->dirty            = false;
+
+    for (n = 0; n < bus->discharges_count; n++) {
+        bus->discharges[n] = layout->discharges[n];
+    }
+}
+
+void icemu_bus_resolve(icemu_t * ic, bux_t bu) {
+    bus_t * bus = &ic->buses[bu];
+    bit_t closed = bus->type == TRANSISTOR_NMOS ? BIT_ONE : BIT_ZERO;
+    unsigned long word = 0;
+    bool_t up;
+    size_t n;
+
+    /* Pack closed discharge inputs into one bit per input */
+    for (n = 0; n < bus->discharges_count; n++) {
+        if (ic->nodes[bus->discharges[n]].state == closed) {
+            word |= 1UL << n;
+        }
+    }
+
+    up = ic->nodes[bus->precharge].state == closed;
+
+    if (word != 0 || up) {
+        /* Any closed discharge input wins over the precharge */
+        ic->nodes[bus->output].level = LEVEL_POWER;
+        ic->nodes[bus->output].pull = word != 0 ? PULL_DOWN : PULL_UP;
+        DIRTY_MARK(ic, nodes, bus->output);
+    } else {
+        /* Leave the bus holding its charge */
+        ic->nodes[bus->output].level = LEVEL_FLOAT;
+        ic->nodes[bus->output].pull = PULL_FLOAT;
+    }
+
+    /* Clear bus dirty flag */
+    DIRTY_CLEAR(ic, buses, bu);
+}
+
+/* ================ */
+/*    Clock tree    */
+/* ================ */
+
+/* --- Private functions  --- */
+
+void icemu_clock_init(icemu_t * ic, ckx_t ck, const clock_tree_t * layout) {
+    clock_tree_t * clock = &ic->clocks[ck];
+
+    /* Initialize clock tree properties */
+    *clock = *layout;
+
+    /* The phase is unknown until the input first resolves */
+    clock->phase = BIT_Z;
+    clock->step  = 0;
+    clock->dirty = false;
+}
+
+void icemu_clock_resolve(icemu_t * ic, ckx_t ck) {
+    clock_tree_t * clock = &ic->clocks[ck];
+    bit_t phase = ic->nodes[clock->input].state == BIT_ONE ? BIT_ONE : BIT_ZERO;
+    bool_t changed = false;
+    size_t o, c;
+
+    if (clock->phase == BIT_Z) {
+        /* Settle the whole tree at once */
+        for (o = clock->outputs_start; o < clock->outputs_start + clock->outputs_count; o++) {
+            const clock_output_t * output = &ic->clock_outputs[o];
+
+            changed |= icemu_clock_apply(ic, output, phase == BIT_ONE ? output->high : output->low);
+        }
+
+        if (changed) {
+            icemu_clock_notify(ic, ic->clock_steps_count + ck);
+        }
+
+        clock->phase = phase;
+        clock->step = clock->steps_count[phase];
+    } else {
+        /* Start a new edge whenever the input changes phase */
+        if (phase != clock->phase) {
+            clock->phase = phase;
+            clock->step = 0;
+        }
+
+        /* Replay one step of the edge per iteration, as the tree it stands for would switch */
+        if (clock->step < clock->steps_count[phase]) {
+            const clock_step_t * step = &ic->clock_steps[clock->steps_start[phase] + clock->step];
+
+            for (c = step->changes_start; c < step->changes_start + step->changes_count; c++) {
+                icemu_clock_apply(ic, &ic->clock_outputs[ic->clock_changes[c].output], ic->clock_changes[c].state);
+            }
+
+            icemu_clock_notify(ic, clock->steps_start[phase] + clock->step);
+
+            clock->step++;
+        }
+    }
+
+    /* Stay dirty until the edge is complete */
+    if (clock->step < clock->steps_count[phase]) {
+        DIRTY_MARK(ic, clocks, ck);
+    } else {
+        DIRTY_CLEAR(ic, clocks, ck);
+    }
+}
+
+bool_t icemu_clock_apply(icemu_t * ic, const clock_output_t * output, bit_t state) {
+    node_t * node = &ic->nodes[output->node];
+
+    node->level = bit_level(state, output->logic);
+    node->pull = bit_pull(state);
+
+    if (node->state == state) {
+        return false;
+    }
+
+    node->state = state;
+
+    return true;
+}
+
+void icemu_clock_notify(icemu_t * ic, size_t b) {
+    size_t m;
+
+    for (m = ic->clock_blocks[b]; m < ic->clock_blocks[b + 1]; m++) {
+        DIRTY_APPLY(ic->clock_marks[m]);
+    }
+}
+
+size_t icemu_clock_block(icemu_t * ic, size_t b, dirty_t * marks) {
+    size_t count = 0, i;
+
+    if (b < ic->clock_steps_count) {
+        const clock_step_t * step = &ic->clock_steps[b];
+
+        for (i = step->changes_start; i < step->changes_start + step->changes_count; i++) {
+            count = icemu_clock_fanout(ic, ic->clock_outputs[ic->clock_changes[i].output].node, marks, count);
+        }
+    } else {
+        const clock_tree_t * clock = &ic->clocks[b - ic->clock_steps_count];
+
+        for (i = clock->outputs_start; i < clock->outputs_start + clock->outputs_count; i++) {
+            count = icemu_clock_fanout(ic, ic->clock_outputs[i].node, marks, count);
+        }
+    }
+
+    return count;
+}
+
+size_t icemu_clock_fanout(icemu_t * ic, nx_t n, dirty_t * marks, size_t count) {
+    size_t i;
+
+    for (i = 0; i < ic->node_gates_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, transistors, ic->node_gates[n][i]));
+    }
+
+    for (i = 0; i < ic->node_buffers_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, buffers, ic->node_buffers[n][i]));
+    }
+
+    for (i = 0; i < ic->node_functions_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, functions, ic->node_functions[n][i]));
+    }
+
+    for (i = 0; i < ic->node_cells_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, cells, ic->node_cells[n][i]));
+    }
+
+    for (i = 0; i < ic->node_words_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, words, ic->node_words[n][i]));
+    }
+
+    for (i = 0; i < ic->node_plas_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, plas, ic->node_plas[n][i]));
+    }
+
+    for (i = 0; i < ic->node_chains_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, chains, ic->node_chains[n][i]));
+    }
+
+    for (i = 0; i < ic->node_passes_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, passes, ic->node_passes[n][i]));
+    }
+
+    for (i = 0; i < ic->node_buses_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, buses, ic->node_buses[n][i]));
+    }
+
+    for (i = 0; i < ic->node_clocks_counts[n]; i++) {
+        count = icemu_dirty_merge(marks, count, DIRTY_REF(ic, clocks, ic->node_clocks[n][i]));
+    }
+
+    return count;
+}
+
+/* ==================== */
+/*    Dirty tracking    */
+/* ==================== */
+
+/* --- Private functions  --- */
+
+size_t icemu_dirty_merge(dirty_t * marks, size_t count, dirty_t dirty) {
+    size_t m;
+
+    /* Only count the mark when sizing a list */
+    if (marks == NULL) {
+        return count + 1;
+    }
+
+    /* Marks for the same item, or for items sharing a bitset word, are applied together */
+    for (m = 0; m < count; m++) {
+#ifdef DIRTY_BITSET
+        if (marks[m].word == dirty.word) {
+            marks[m].mask |= dirty.mask;
+            return count;
+        }
+#else
+        if (marks[m] == dirty) {
+            return count;
+        }
+#endif
+    }
+
+    marks[count] = dirty;
+
+    return count + 1;
+}
+
+#ifdef DIRTY_BITSET
+dirty_t icemu_dirty_ref(unsigned long * set, size_t i) {
+    dirty_t ref;
+
+    ref.word = &set[i / DIRTY_BITS];
+    ref.mask = 1UL << (i % DIRTY_BITS);
+
+    return ref;
+}
+
+size_t icemu_dirty_next(const unsigned long * set, size_t i, size_t count) {
+    size_t w = i / DIRTY_BITS;
+    unsigned long word;
+
+    if (i >= count) {
+        return count;
+    }
+
+    /* Ignore bits before the start of the search, then skip clean words */
+    word = set[w] & (~0UL << (i % DIRTY_BITS));
+
+    while (word == 0) {
+        if (++w >= DIRTY_WORDS(count)) {
+            return count;
+        }
+
+        word = set[w];
+    }
+
+#ifdef __GNUC__
+    return w * DIRTY_BITS + __builtin_ctzl(word);
+#else
+    for (i = w * DIRTY_BITS; !(word & 1UL); word >>= 1) {
+        i++;
+    }
+
+    return i;
+#endif
+}
+#endif
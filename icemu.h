@@ -39,6 +39,19 @@ typedef enum {
 
 char bit_char(bit_t bit);
 
+/* --- Dirty tracking --- */
+
+/* Items are marked dirty with a flag of their own by default. Building with -DDIRTY_BITSET keeps one dense
+   bitset per item type instead, so dirty items are found a word at a time. A mark refers to either. */
+#ifdef DIRTY_BITSET
+typedef struct {
+    unsigned long * word;
+    unsigned long mask;
+} dirty_t;
+#else
+typedef bool_t * dirty_t;
+#endif
+
 /* --- Node --- */
 
 typedef size_t nx_t;
@@ -87,6 +100,7 @@ typedef struct {
     nx_t input;
     nx_t output;
     bool_t dirty;
+    bool_t immediate;
 } buffer_t;
 
 /* --- Function --- */
@@ -97,6 +111,12 @@ typedef bit_t (* function_func_t)(bit_t, bit_t, bit_t, bit_t, bit_t, bit_t, bit_
 
 enum { FUNCTION_INPUTS = 9 };
 
+typedef enum {
+    FUNCTION_CUSTOM = 0,
+    FUNCTION_NOR    = 1,
+    FUNCTION_NAND   = 2
+} function_kind_t;
+
 typedef struct {
     logic_t logic;
     function_func_t func;
@@ -104,6 +124,8 @@ typedef struct {
     size_t inputs_count;
     nx_t output;
     bool_t dirty;
+    function_kind_t kind;
+    bool_t immediate;
 } function_t;
 
 /* --- Cell --- */
@@ -136,6 +158,131 @@ typedef struct {
     bool_t dirty;
 } cell_t;
 
+/* --- Word --- */
+
+typedef size_t wx_t;
+
+enum { WORD_BITS = 16 };
+
+typedef struct {
+    logic_t logic;
+    cell_type_t type;
+    nx_t inputs[WORD_BITS];
+    nx_t outputs[WORD_BITS];
+    size_t bits;
+    nx_t writes[CELL_WRITES];
+    size_t writes_count;
+    nx_t reads[CELL_READS];
+    size_t reads_count;
+    unsigned int state;
+    bool_t latched;
+    unsigned int output;
+    bool_t driven;
+    bool_t emitted;
+    bool_t dirty;
+} word_t;
+
+/* --- PLA --- */
+
+typedef size_t px_t;
+
+enum { PLA_INPUTS = 32 };
+
+typedef struct {
+    unsigned long mask;
+    nx_t output;
+    bit_t state;
+} pla_term_t;
+
+typedef struct {
+    logic_t logic;
+    nx_t inputs[PLA_INPUTS];
+    size_t inputs_count;
+    size_t terms_start;
+    size_t terms_count;
+    bool_t dirty;
+} pla_t;
+
+/* --- Chain --- */
+
+typedef size_t chx_t;
+
+typedef struct {
+    size_t stages_start;
+    size_t stages_count;
+    bool_t dirty;
+} chain_t;
+
+/* --- Pass gate --- */
+
+typedef size_t pgx_t;
+
+typedef struct {
+    transistor_type_t type;
+    nx_t gate;
+    nx_t input;
+    nx_t output;
+    bool_t dirty;
+} pass_t;
+
+/* --- Precharged bus --- */
+
+typedef size_t bux_t;
+
+enum { BUS_DISCHARGES = 32 };
+
+typedef struct {
+    transistor_type_t type;
+    nx_t precharge;
+    nx_t discharges[BUS_DISCHARGES];
+    size_t discharges_count;
+    nx_t output;
+    bool_t dirty;
+} bus_t;
+
+/* --- Clock tree --- */
+
+typedef size_t ckx_t;
+
+typedef struct {
+    logic_t logic;
+    nx_t node;
+    bit_t low;
+    bit_t high;
+} clock_output_t;
+
+typedef struct {
+    size_t changes_start;
+    size_t changes_count;
+} clock_step_t;
+
+typedef struct {
+    size_t output;
+    bit_t state;
+} clock_change_t;
+
+typedef struct {
+    nx_t input;
+    size_t outputs_start;
+    size_t outputs_count;
+    size_t steps_start[2];
+    size_t steps_count[2];
+    bit_t phase;
+    size_t step;
+    bool_t dirty;
+} clock_tree_t;
+
+/* --- Channel-connected component --- */
+
+typedef size_t ccx_t;
+
+typedef struct {
+    size_t nodes_start;
+    size_t nodes_count;
+    size_t transistors_start;
+    size_t transistors_count;
+} ccc_t;
+
 /* --- Device --- */
 
 typedef struct {
@@ -158,6 +305,48 @@ typedef struct {
 
     const cell_t * cells;
     size_t cells_count;
+
+    const word_t * words;
+    size_t words_count;
+
+    const pla_t * plas;
+    size_t plas_count;
+
+    const pla_term_t * pla_terms;
+    size_t pla_terms_count;
+
+    const chain_t * chains;
+    size_t chains_count;
+
+    const function_t * chain_stages;
+    size_t chain_stages_count;
+
+    const pass_t * passes;
+    size_t passes_count;
+
+    const bus_t * buses;
+    size_t buses_count;
+
+    const clock_tree_t * clocks;
+    size_t clocks_count;
+
+    const clock_output_t * clock_outputs;
+    size_t clock_outputs_count;
+
+    const clock_step_t * clock_steps;
+    size_t clock_steps_count;
+
+    const clock_change_t * clock_changes;
+    size_t clock_changes_count;
+
+    const ccc_t * cccs;
+    size_t cccs_count;
+
+    const nx_t * ccc_nodes;
+    size_t ccc_nodes_count;
+
+    const tx_t * ccc_transistors;
+    size_t ccc_transistors_count;
 } icemu_layout_t;
 
 typedef struct {
@@ -179,6 +368,46 @@ typedef struct {
     cell_t * cells;
     size_t cells_count;
 
+    word_t * words;
+    size_t words_count;
+
+    pla_t * plas;
+    size_t plas_count;
+
+    pla_term_t * pla_terms;
+    size_t pla_terms_count;
+
+    chain_t * chains;
+    size_t chains_count;
+
+    function_t * chain_stages;
+    size_t chain_stages_count;
+
+    pass_t * passes;
+    size_t passes_count;
+
+    bus_t * buses;
+    size_t buses_count;
+
+    clock_tree_t * clocks;
+    size_t clocks_count;
+
+    clock_output_t * clock_outputs;
+    size_t clock_outputs_count;
+
+    clock_step_t * clock_steps;
+    size_t clock_steps_count;
+
+    clock_change_t * clock_changes;
+    size_t clock_changes_count;
+
+    dirty_t * clock_marks;
+    size_t * clock_blocks;
+
+    size_t * level_buffers;
+    size_t * level_functions;
+    size_t levels_count;
+
     tx_t ** node_gates;
     tx_t * node_gates_lists;
     size_t * node_gates_counts;
@@ -186,6 +415,7 @@ typedef struct {
     tx_t ** node_channels;
     tx_t * node_channels_lists;
     size_t * node_channels_counts;
+    size_t * node_channels_enabled;
 
     bx_t ** node_buffers;
     bx_t * node_buffers_lists;
@@ -199,8 +429,58 @@ typedef struct {
     cx_t * node_cells_lists;
     size_t * node_cells_counts;
 
+    wx_t ** node_words;
+    wx_t * node_words_lists;
+    size_t * node_words_counts;
+
+    px_t ** node_plas;
+    px_t * node_plas_lists;
+    size_t * node_plas_counts;
+
+    chx_t ** node_chains;
+    chx_t * node_chains_lists;
+    size_t * node_chains_counts;
+
+    pgx_t ** node_passes;
+    pgx_t * node_passes_lists;
+    size_t * node_passes_counts;
+
+    bux_t ** node_buses;
+    bux_t * node_buses_lists;
+    size_t * node_buses_counts;
+
+    ckx_t ** node_clocks;
+    ckx_t * node_clocks_lists;
+    size_t * node_clocks_counts;
+
+#ifdef DIRTY_BITSET
+    unsigned long * nodes_dirty;
+    unsigned long * transistors_dirty;
+    unsigned long * buffers_dirty;
+    unsigned long * functions_dirty;
+    unsigned long * cells_dirty;
+    unsigned long * words_dirty;
+    unsigned long * plas_dirty;
+    unsigned long * chains_dirty;
+    unsigned long * passes_dirty;
+    unsigned long * buses_dirty;
+    unsigned long * clocks_dirty;
+
+    dirty_t ** node_gate_masks;
+    dirty_t * node_gate_masks_lists;
+    size_t * node_gate_masks_counts;
+#endif
+
+    ccc_t * cccs;
+    size_t cccs_count;
+    nx_t * ccc_nodes;
+    tx_t * ccc_transistors;
+    ccx_t * node_cccs;
+    size_t ccc_max_nodes;
+
     nx_t * network_nodes;
     size_t network_nodes_count;
+    bool_t * network_members;
     level_t network_level_down;
     level_t network_level_up;
 } icemu_t;
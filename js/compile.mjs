@@ -2,7 +2,13 @@ import fs from 'fs';
 
 import { Spec } from './lib/spec.mjs';
 import { Layout } from './lib/layout.mjs';
+import { Journal } from './lib/layout/journal.mjs';
+import { Order } from './lib/layout/order.mjs';
 import { Generator } from './lib/generator.mjs';
+import { Verifier } from './lib/verifier.mjs';
+import { Miner } from './lib/layout/miner.mjs';
+import { Cost } from './lib/layout/cost.mjs';
+import { Simulator } from './lib/simulator.mjs';
 
 const STYLE_BOLD = '\x1B[0;1m';
 const STYLE_NONE = '\x1B[0;0m';
@@ -13,13 +19,62 @@ const options = {
     reduceNodes: false,
     reduceCircuits: true,
     cacheLayout: false,
+    jobs: 1,
+    orderNodes: 'none',
+    propagateConstants: false,
+    collapseBuffers: false,
+    buildClockTree: false,
+    buildPasses: false,
+    buildBuses: false,
+    buildPlas: false,
+    buildWords: false,
+    buildChains: false,
+    verifyCycles: 0,
+    bisect: false,
+    mine: false,
+    profile: null,
+    seed: 1,
+    clock: 'clk',
+    reset: 'res',
 }
 
+const VERIFY_CYCLES = 1000;
+
 // Parse command-line options
 const argv = process.argv.slice(2);
 
 for (const arg of argv) {
-    if (arg[0] === '-') {
+    if (arg.startsWith('--jobs=')) {
+        options.jobs = parseInt(arg.substring(7), 10);
+
+        if (!(options.jobs >= 1)) {
+            throw new Error(`Invalid job count in '${arg}'`);
+        }
+    } else if (arg.startsWith('--verify=')) {
+        options.verifyCycles = parseInt(arg.substring(9), 10);
+
+        if (!(options.verifyCycles >= 1)) {
+            throw new Error(`Invalid cycle count in '${arg}'`);
+        }
+    } else if (arg.startsWith('--seed=')) {
+        options.seed = parseInt(arg.substring(7), 10);
+
+        if (isNaN(options.seed)) {
+            throw new Error(`Invalid seed in '${arg}'`);
+        }
+    } else if (arg.startsWith('--clock=')) {
+        options.clock = arg.substring(8);
+    } else if (arg.startsWith('--reset=')) {
+        options.reset = arg.substring(8);
+    } else if (arg.startsWith('--profile=')) {
+        options.profile = arg.substring(10);
+    } else if (arg.startsWith('--order=')) {
+        options.orderNodes = arg.substring(8);
+
+        if (!Order.getModes().includes(options.orderNodes)) {
+            throw new Error(`Invalid node order in '${arg}'`);
+        }
+    } else if (arg[0] === '-') {
         switch (arg) {
             case '--reduce':
                 options.reduceNodes = true;
@@ -33,6 +88,64 @@ for (const arg of argv) {
             case '--no-circuits':
                 options.reduceCircuits = false;
                 break;
+            case '--constants':
+                options.propagateConstants = true;
+                break;
+            case '--no-constants':
+                options.propagateConstants = false;
+                break;
+            case '--buffers':
+                options.collapseBuffers = true;
+                break;
+            case '--no-buffers':
+                options.collapseBuffers = false;
+                break;
+            case '--clock-tree':
+                options.buildClockTree = true;
+                break;
+            case '--no-clock-tree':
+                options.buildClockTree = false;
+                break;
+            case '--passes':
+                options.buildPasses = true;
+                break;
+            case '--no-passes':
+                options.buildPasses = false;
+                break;
+            case '--buses':
+                options.buildBuses = true;
+                break;
+            case '--no-buses':
+                options.buildBuses = false;
+                break;
+            case '--pla':
+                options.buildPlas = true;
+                break;
+            case '--no-pla':
+                options.buildPlas = false;
+                break;
+            case '--words':
+                options.buildWords = true;
+                break;
+            case '--no-words':
+                options.buildWords = false;
+                break;
+            case '--chains':
+                options.buildChains = true;
+                break;
+            case '--no-chains':
+                options.buildChains = false;
+                break;
+            case '--verify':
+                options.verifyCycles = VERIFY_CYCLES;
+                break;
+            case '--bisect':
+                options.verifyCycles = options.verifyCycles || VERIFY_CYCLES;
+                options.bisect = true;
+                break;
+            case '--mine':
+                options.mine = true;
+                break;
             case '--cache':
                 options.cacheLayout = true;
                 break;
@@ -74,46 +187,200 @@ try {
     process.exit(1);
 }
 
-// Construct cached spec from JSON
-if (fs.existsSync(cachePath)) {
-    console.log(`${STYLE_BOLD}Validating device spec (from cache)...${STYLE_NONE}`);
+// Compare the reduced layout against the unreduced netlist instead of generating code
+if (options.verifyCycles) {
+    console.log(`${STYLE_BOLD}Verifying reductions over ${options.verifyCycles} cycles (seed ${options.seed})...${STYLE_NONE}`);
 
     try {
-        var cacheSpec = new Spec(JSON.parse(fs.readFileSync(cachePath, { encoding: 'ascii' })));
+        const verifier = new Verifier(spec, {
+            cycles: options.verifyCycles,
+            seed: options.seed,
+            clock: options.clock,
+            reset: options.reset,
+            layout: {
+                jobs: options.jobs,
+                propagateConstants: options.propagateConstants,
+                collapseBuffers: options.collapseBuffers,
+                buildClockTree: options.buildClockTree,
+                buildPasses: options.buildPasses,
+                buildBuses: options.buildBuses,
+                buildPlas: options.buildPlas,
+                buildWords: options.buildWords,
+                buildChains: options.buildChains,
+            },
+        });
+
+        const divergence = verifier.verify();
+
+        console.log();
+
+        if (!divergence) {
+            console.log(`${STYLE_BOLD}No divergence${STYLE_NONE}`);
+            process.exit(0);
+        }
+
+        printDivergence(divergence);
+
+        if (options.bisect) {
+            console.log();
+            console.log(`${STYLE_BOLD}Bisecting reductions...${STYLE_NONE}`);
+
+            const result = verifier.bisect();
+
+            console.log();
+
+            if (result.pass) {
+                console.log(`${STYLE_BOLD}First diverging pass: ${result.pass}${STYLE_NONE}`);
+            } else {
+                console.log(`${STYLE_BOLD}First diverging reduction: instance ${result.instance} ` +
+                    `of circuit '${result.circuit.id}'${STYLE_NONE}`);
+            }
+
+            printDivergence(result.divergence);
+        }
     } catch (e) {
-        console.error(`Error parsing ${cachePath}: ${e.message}`);
+        console.error(`Error verifying device layout: ${e.message}`);
         process.exit(1);
     }
+
+    process.exit(1);
 }
 
-// Construct layout from device spec
-if (cacheSpec) {
-    console.log(`${STYLE_BOLD}Compiling device layout (from cache)...${STYLE_NONE}`);
-} else {
-    console.log(`${STYLE_BOLD}Compiling device layout...${STYLE_NONE}`);
+function printDivergence(d) {
+    const bits = states => states.map(Simulator.getBitChar).join(' -> ');
+
+    console.log(`Pin ${d.pin} diverges at cycle ${d.cycle} (step ${d.step}): ${bits(d.states)}`);
+    console.log(`Inputs: ${Object.entries(d.inputs).map(([id, v]) => `${id}=${v.toString(16)}`).join(' ')}`);
+
+    if (d.first) {
+        console.log(`First internal divergence at step ${d.first.step} in ${d.first.count} nodes:`);
+
+        d.first.nodes.forEach(n => {
+            console.log(`  ${String(n.node).padEnd(6)} ${bits(n.states)}${n.names.length ? `  (${n.names.join(', ')})` : ''}`);
+        });
+    }
+}
+
+function printCost(estimate) {
+    const total = estimate.steps[0].cost,
+          percent = v => total ? `${(100 * v / total).toFixed(1)}%` : '-';
+
+    console.log(`Profiled nodes: ${estimate.profiled}`);
+    console.log();
+    console.log('Step                      Cost      Saved   Share');
+
+    estimate.steps.forEach(s => {
+        console.log(`${s.label.padEnd(20)} ${String(s.cost).padStart(9)} ${String(s.saved).padStart(10)} ${percent(s.saved).padStart(7)}`);
+    });
+
+    console.log();
+    console.log('Region                  Nodes     Before      After');
+
+    estimate.regions.forEach(r => {
+        console.log(`${r.name.padEnd(20)} ${String(r.nodes).padStart(8)} ${String(r.before).padStart(10)} ${String(r.after).padStart(10)}`);
+    });
+}
+
+// Load reductions cached by a previous compile
+if (options.cacheLayout) {
+    var journal = new Journal(spec, null);
+
+    if (fs.existsSync(cachePath)) {
+        try {
+            journal = new Journal(spec, JSON.parse(fs.readFileSync(cachePath, { encoding: 'ascii' })));
+        } catch (e) {
+            console.error(`Ignoring unreadable cache ${cachePath}: ${e.message}`);
+        }
+    }
+}
+
+// Load a runtime profile to estimate the cost of each reduction
+if (options.profile) {
+    try {
+        var cost = new Cost(fs.readFileSync(options.profile, { encoding: 'ascii' }));
+    } catch (e) {
+        console.error(`Error reading profile '${options.profile}': ${e.message}`);
+        process.exit(1);
+    }
 }
 
-const activeSpec = cacheSpec ? cacheSpec : spec;
+// Construct layout from device spec
+console.log(`${STYLE_BOLD}Compiling device layout...${STYLE_NONE}`);
 
 try {
-    var layout = new Layout(activeSpec, {
+    var layout = new Layout(spec, {
         reduceNodes: options.reduceNodes,
         reduceCircuits: options.reduceCircuits,
+        jobs: options.jobs,
+        journal: journal,
+        orderNodes: options.orderNodes,
+        propagateConstants: options.propagateConstants,
+        collapseBuffers: options.collapseBuffers,
+        buildClockTree: options.buildClockTree,
+        buildPasses: options.buildPasses,
+        buildBuses: options.buildBuses,
+        buildPlas: options.buildPlas,
+        buildWords: options.buildWords,
+        buildChains: options.buildChains,
+        clock: options.clock,
+        cost: cost,
     });
 } catch (e) {
     console.error(`Error compiling device layout: ${e.message}`);
     process.exit(1);
 }
 
-// Write new cached spec file
+// Propose new circuits from repeated subgraphs instead of generating code
+if (options.mine) {
+    const minedFile = 'icemu.mined.json',
+          minedPath = `${options.deviceDir}${minedFile}`;
+
+    console.log(`${STYLE_BOLD}Mining repeated subgraphs...${STYLE_NONE}`);
+
+    const candidates = new Miner(layout).mine();
+
+    console.log();
+    console.log(`${STYLE_BOLD}Candidates${STYLE_NONE}`);
+    console.log('Rank  Score  Instances  Transistors  Loads  Inputs  Outputs  Circuit');
+
+    candidates.forEach((c, idx) => {
+        console.log([
+            `#${idx + 1}`.padEnd(5),
+            String(c.score).padStart(5),
+            String(c.instances).padStart(10),
+            String(c.transistors).padStart(12),
+            String(c.loads).padStart(6),
+            String(c.inputs).padStart(7),
+            String(c.outputs).padStart(8),
+            ` ${c.circuit ? `${c.circuit.id} (${c.circuit.args[1]})` : '-'}`,
+        ].join(' '));
+    });
+
+    // Larger circuits go first, since a smaller one can match inside them and would leave them nothing to reduce
+    const circuits = candidates.map(c => c.circuit).filter(Boolean)
+        .sort((a, b) => b.transistors.length - a.transistors.length);
+
+    try {
+        fs.writeFileSync(minedPath, JSON.stringify({ circuits: circuits }, null, 2));
+    } catch (e) {
+        console.error(`Error writing ${minedPath}: ${e.message}`);
+        process.exit(1);
+    }
+
+    console.log();
+    console.log(`Wrote ${circuits.length} circuits to ${minedPath}`);
+    process.exit(0);
+}
+
+// Write reductions for the next compile
 try {
     var newSpec = layout.buildSpec();
 
     if (options.cacheLayout) {
-        fs.writeFileSync(cachePath, JSON.stringify(newSpec, null, "    "));
+        fs.writeFileSync(cachePath, JSON.stringify(journal.buildSpec()));
     }
 } catch (e) {
-    console.error(`Error caching compiled spec: ${e.message}`);
+    console.error(`Error caching circuit reductions: ${e.message}`);
     process.exit(1);
 }
 
@@ -134,16 +401,16 @@ console.log()
 console.log(`${STYLE_BOLD}Device Spec${STYLE_NONE}`);
 spec.printInfo();
 
-if (cacheSpec) {
-    console.log()
-    console.log(`${STYLE_BOLD}Device Spec (from cache)${STYLE_NONE}`);
-    cacheSpec.printInfo();
-}
-
 console.log();
 console.log(`${STYLE_BOLD}Device Layout${STYLE_NONE}`);
 layout.printInfo();
 
+if (cost) {
+    console.log();
+    console.log(`${STYLE_BOLD}Estimated Cost${STYLE_NONE}`);
+    printCost(cost.estimate());
+}
+
 console.log();
 console.log(`${STYLE_BOLD}Generated Files${STYLE_NONE}`);
 generator.printInfo();
@@ -3,6 +3,12 @@ import { Transistor } from './components/transistor.mjs';
 import { Buffer } from './components/buffer.mjs';
 import { Function } from './components/function.mjs';
 import { Cell } from './components/cell.mjs';
+import { Pla } from './components/pla.mjs';
+import { Word } from './components/word.mjs';
+import { Chain } from './components/chain.mjs';
+import { Pass } from './components/pass.mjs';
+import { Bus } from './components/bus.mjs';
+import { Clock } from './components/clock.mjs';
 
 const TYPES = {
     load: Load,
@@ -10,6 +16,12 @@ const TYPES = {
     buffer: Buffer,
     'function': Function,
     cell: Cell,
+    pla: Pla,
+    word: Word,
+    chain: Chain,
+    pass: Pass,
+    bus: Bus,
+    clock: Clock,
 };
 
 export class Components {
@@ -26,9 +38,14 @@ export class Components {
         return TYPES[type].compatible(a, b);
     }
 
+    static getComparator(type) {
+        return TYPES[type].compare;
+    }
+
     constructor() {
         this.components = Object.fromEntries(Object.keys(TYPES).map(key => [key, []]));
         this.maps = Object.fromEntries(Object.keys(TYPES).map(key => [key, {}]));
+        this.sorted = {};
 
         Components.getTypes().forEach(type => {
             Components.getGroups(type).forEach(group => {
@@ -50,7 +67,13 @@ export class Components {
     }
 
     getComponents(type) {
-        return this.components[type].filter(c => !c.__reduce).sort(TYPES[type].compare);
+
+        // Sorting is cached until components are added or reduced
+        if (!this.sorted[type]) {
+            this.sorted[type] = this.components[type].filter(c => !c.__reduce).sort(TYPES[type].compare);
+        }
+
+        return this.sorted[type].slice();
     }
 
     getIndices(type) {
@@ -74,6 +97,8 @@ export class Components {
     addComponents(type, specs) {
         let components = specs.map(spec => new TYPES[type](-1, ...spec));
 
+        delete this.sorted[type];
+
         components.forEach((c, i) => {
 
             // Assign the next available index
@@ -106,9 +131,40 @@ export class Components {
                 });
             }
         });
+
+        return components;
+    }
+
+    remapNodes(type, map) {
+        delete this.sorted[type];
+
+        this.components[type].filter(c => !c.__reduce).forEach(c => c.remapNodes(map));
+
+        // Rebuild node maps for the remapped components
+        Components.getGroups(type).forEach(group => {
+            this.maps[type][group] = {};
+        });
+
+        this.components[type].filter(c => !c.__reduce).forEach(c => {
+            Components.getGroups(type).forEach(group => {
+                const groupNodes = c.getGroupNodes(group);
+
+                if (groupNodes) {
+                    groupNodes.forEach(n => {
+                        if (this.maps[type][group][n]) {
+                            this.maps[type][group][n].push(c.idx);
+                        } else {
+                            this.maps[type][group][n] = [c.idx];
+                        }
+                    });
+                }
+            });
+        });
     }
 
     reduceComponents(type, indices) {
+        delete this.sorted[type];
+
         indices.forEach(idx => {
             let c = this.components[type][idx];
 
@@ -42,6 +42,14 @@ export class Buffer {
         return [this.input, this.output];
     }
 
+    getInputNodes() {
+        return [this.input];
+    }
+
+    getOutputNodes() {
+        return [this.output];
+    }
+
     getGroupNodes(group) {
         return {
             input: [this.input],
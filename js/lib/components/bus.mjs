@@ -0,0 +1,78 @@
+import { Util } from '../util.mjs';
+import { Validator } from '../validator.mjs';
+
+const MAX_DISCHARGES = 32;
+
+export class Bus {
+
+    constructor(idx, type, precharge, discharges, output) {
+        this.idx = idx;
+        this.type = type;
+        this.precharge = precharge;
+        this.discharges = discharges;
+        this.output = output;
+
+        if (discharges.length > MAX_DISCHARGES) {
+            throw new Error(`Buses with more than ${MAX_DISCHARGES} discharge inputs are not supported`);
+        }
+    }
+
+    static getMaxDischarges() {
+        return MAX_DISCHARGES;
+    }
+
+    static compare(a, b) {
+        return a.type.localeCompare(b.type) ||
+            a.precharge - b.precharge ||
+            Util.compareArrays(a.discharges, b.discharges) ||
+            a.output - b.output;
+    }
+
+    static compatible(a, b) {
+        return a.type === b.type &&
+            a.discharges.length === b.discharges.length;
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            (f, v) => Validator.validateEnum(f, v, ['nmos', 'pmos']),
+            Validator.validateNode,
+            (f, v) => Validator.validateArray(f, v, 1, MAX_DISCHARGES, Validator.validateNode),
+            Validator.validateNode,
+        ]);
+    }
+
+    static getGroups() {
+        return ['precharge', 'discharge', 'output'];
+    }
+
+    getSpec() {
+        return [this.type, this.precharge, this.discharges, this.output];
+    }
+
+    getAllNodes() {
+        return [this.precharge, ...this.discharges, this.output];
+    }
+
+    getInputNodes() {
+        return [this.precharge, ...this.discharges];
+    }
+
+    getOutputNodes() {
+        return [this.output];
+    }
+
+    getGroupNodes(group) {
+        return {
+            precharge: [this.precharge],
+            discharge: this.discharges,
+            output: [this.output],
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.precharge = map[this.precharge];
+        this.discharges = this.discharges.map(n => map[n]);
+        this.output = map[this.output];
+    }
+}
@@ -92,6 +92,14 @@ export class Cell {
         return [...this.inputs, ...this.outputs, ...this.writes, ...this.reads];
     }
 
+    getInputNodes() {
+        return [...this.inputs, ...this.writes, ...this.reads];
+    }
+
+    getOutputNodes() {
+        return this.outputs;
+    }
+
     getGroupNodes(group) {
         let groupNodes = {};
 
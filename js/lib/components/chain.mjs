@@ -0,0 +1,79 @@
+import { Util } from '../util.mjs';
+import { Validator } from '../validator.mjs';
+import { Function } from './function.mjs';
+
+const GROUPS = [
+    'input',
+    'output',
+];
+
+export class Chain {
+
+    constructor(idx, stages) {
+        this.idx = idx;
+
+        // Stages are functions evaluated in order, each reading the outputs of the stages before it
+        this.stages = stages.map(spec => new Function(-1, ...spec));
+
+        const outputs = new Set();
+
+        this.inputs = [];
+
+        this.stages.forEach(f => {
+            f.inputs.forEach(n => {
+                if (!outputs.has(n) && !this.inputs.includes(n)) {
+                    this.inputs.push(n);
+                }
+            });
+
+            outputs.add(f.output);
+        });
+    }
+
+    static compare(a, b) {
+        return Util.compareArrays(a.getOutputNodes(), b.getOutputNodes());
+    }
+
+    static compatible(a, b) {
+        return a.stages.length === b.stages.length &&
+            a.stages.every((f, i) => Function.compatible(f, b.stages[i]));
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            (f, v) => Validator.validateArray(f, v, 1, undefined, Function.validateSpec),
+        ]);
+    }
+
+    static getGroups() {
+        return GROUPS;
+    }
+
+    getSpec() {
+        return [this.stages.map(f => f.getSpec())];
+    }
+
+    getAllNodes() {
+        return [...this.inputs, ...this.getOutputNodes()];
+    }
+
+    getInputNodes() {
+        return this.inputs;
+    }
+
+    getOutputNodes() {
+        return this.stages.map(f => f.output);
+    }
+
+    getGroupNodes(group) {
+        return {
+            input: this.inputs,
+            output: this.getOutputNodes(),
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.stages.forEach(f => f.remapNodes(map));
+        this.inputs = this.inputs.map(n => map[n]);
+    }
+}
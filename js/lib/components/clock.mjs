@@ -0,0 +1,79 @@
+import { Util } from '../util.mjs';
+import { Validator } from '../validator.mjs';
+
+export class Clock {
+
+    constructor(idx, input, outputs, edges) {
+        this.idx = idx;
+        this.input = input;
+
+        // Each output settles to a known state in each phase of the input
+        this.outputs = outputs.map(([logic, output, low, high]) => ({ logic, output, low, high }));
+
+        // Changes made on the way into each phase, one list of output indices and states per resolve iteration
+        this.edges = edges;
+
+        if (edges.some(steps => steps.some(changes => changes.some(([k]) => k >= outputs.length)))) {
+            throw new Error('Clock edge refers to a missing output');
+        }
+    }
+
+    static compare(a, b) {
+        return a.input - b.input ||
+            Util.compareArrays(a.getOutputNodes(), b.getOutputNodes());
+    }
+
+    static compatible(a, b) {
+        return a.outputs.length === b.outputs.length;
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            Validator.validateNode,
+            (f, v) => Validator.validateArray(f, v, 1, undefined, (f, v) => Validator.validateTuple(f, v, [
+                (f, v) => Validator.validateEnum(f, v, ['nmos', 'pmos', 'cmos', 'ttl']),
+                Validator.validateNode,
+                (f, v) => Validator.validateInt(f, v, 0, 1),
+                (f, v) => Validator.validateInt(f, v, 0, 1),
+            ])),
+            (f, v) => Validator.validateArray(f, v, 2, (f, v) => Validator.validateArray(f, v, (f, v) => {
+                return Validator.validateArray(f, v, 1, undefined, (f, v) => Validator.validateTuple(f, v, [
+                    Validator.validateIndex,
+                    (f, v) => Validator.validateInt(f, v, -2, 1),
+                ]));
+            })),
+        ]);
+    }
+
+    static getGroups() {
+        return ['input', 'output'];
+    }
+
+    getSpec() {
+        return [this.input, this.outputs.map(o => [o.logic, o.output, o.low, o.high]), this.edges];
+    }
+
+    getAllNodes() {
+        return [this.input, ...this.getOutputNodes()];
+    }
+
+    getInputNodes() {
+        return [this.input];
+    }
+
+    getOutputNodes() {
+        return this.outputs.map(o => o.output);
+    }
+
+    getGroupNodes(group) {
+        return {
+            input: [this.input],
+            output: this.getOutputNodes(),
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.input = map[this.input];
+        this.outputs.forEach(o => { o.output = map[o.output]; });
+    }
+}
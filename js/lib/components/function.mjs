@@ -6,6 +6,11 @@ const MAX_PARAMS = 9;
 
 const PATTERN = /^([a-z]+)\((.*)\)$/;
 
+const GROUPS = [
+    ...[...Array(MAX_GROUPS).keys()].map(k => `group_${k + 1}`),
+    'output',
+];
+
 const OPS = {
     nand: true,
     nor: true,
@@ -152,20 +157,41 @@ export class Function {
     }
 
     static getGroups() {
-        return [
-            ...[...Array(MAX_GROUPS).keys()].map(k => `group_${k + 1}`),
-            'output',
-        ];
+        return GROUPS;
     }
 
     getSpec() {
         return [this.logic, this.expr, this.inputs, this.output];
     }
 
+    // Evaluate the function over input values given in input order, matching the generated C code
+    evaluate(values) {
+
+        function evaluateImpl(func) {
+            if (func.param) {
+                return values[paramToIndex(func.param)] ? 1 : 0;
+            }
+
+            const args = func.args.map(evaluateImpl);
+
+            return (func.op === 'nand' ? args.every(Boolean) : args.some(Boolean)) ? 0 : 1;
+        }
+
+        return evaluateImpl(this.func);
+    }
+
     getAllNodes() {
         return [...this.inputs, this.output];
     }
 
+    getInputNodes() {
+        return this.inputs;
+    }
+
+    getOutputNodes() {
+        return [this.output];
+    }
+
     getGroupNodes(group) {
         let groupNodes = Object.fromEntries([...Array(MAX_GROUPS).keys()].map(k => [
             `group_${k + 1}`,
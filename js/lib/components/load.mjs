@@ -35,6 +35,14 @@ export class Load {
         return [this.node];
     }
 
+    getInputNodes() {
+        return [];
+    }
+
+    getOutputNodes() {
+        return [this.node];
+    }
+
     getGroupNodes(group) {
         return {
             node: [this.node],
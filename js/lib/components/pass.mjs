@@ -0,0 +1,66 @@
+import { Validator } from '../validator.mjs';
+
+export class Pass {
+
+    constructor(idx, type, gate, input, output) {
+        this.idx = idx;
+        this.type = type;
+        this.gate = gate;
+        this.input = input;
+        this.output = output;
+    }
+
+    static compare(a, b) {
+        return a.type.localeCompare(b.type) ||
+            a.gate - b.gate ||
+            a.input - b.input ||
+            a.output - b.output;
+    }
+
+    static compatible(a, b) {
+        return a.type === b.type;
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            (field, val) => Validator.validateEnum(field, val, ['nmos', 'pmos']),
+            Validator.validateNode,
+            Validator.validateNode,
+            Validator.validateNode,
+        ]);
+    }
+
+    static getGroups() {
+        return ['gate', 'input', 'output'];
+    }
+
+    getSpec() {
+        return [this.type, this.gate, this.input, this.output];
+    }
+
+    getAllNodes() {
+        return [this.gate, this.input, this.output];
+    }
+
+    getInputNodes() {
+        return [this.gate, this.input];
+    }
+
+    getOutputNodes() {
+        return [this.output];
+    }
+
+    getGroupNodes(group) {
+        return {
+            gate: [this.gate],
+            input: [this.input],
+            output: [this.output],
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.gate = map[this.gate];
+        this.input = map[this.input];
+        this.output = map[this.output];
+    }
+}
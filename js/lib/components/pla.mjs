@@ -0,0 +1,88 @@
+import { Util } from '../util.mjs';
+import { Validator } from '../validator.mjs';
+
+const MAX_INPUTS = 32;
+
+const GROUPS = [
+    'input',
+    'output',
+];
+
+export class Pla {
+
+    constructor(idx, logic, inputs, terms) {
+        this.idx = idx;
+        this.logic = logic;
+        this.inputs = inputs;
+
+        // Each term is a NOR over a subset of the inputs, given as input indices
+        this.terms = terms.map(([output, mask]) => [output, mask.slice().sort((a, b) => a - b)]);
+
+        if (inputs.length > MAX_INPUTS) {
+            throw new Error(`PLAs with more than ${MAX_INPUTS} inputs are not supported`);
+        }
+
+        if (this.terms.some(([, mask]) => mask.some(i => i >= inputs.length))) {
+            throw new Error('PLA term refers to a missing input');
+        }
+    }
+
+    static getMaxInputs() {
+        return MAX_INPUTS;
+    }
+
+    static compare(a, b) {
+        return a.logic.localeCompare(b.logic) ||
+            Util.compareArrays(a.inputs, b.inputs) ||
+            Util.compareArrays(a.getOutputNodes(), b.getOutputNodes());
+    }
+
+    static compatible(a, b) {
+        return a.logic === b.logic &&
+            a.inputs.length === b.inputs.length &&
+            a.terms.length === b.terms.length;
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            (f, v) => Validator.validateEnum(f, v, ['nmos', 'pmos', 'cmos', 'ttl']),
+            (f, v) => Validator.validateArray(f, v, 0, MAX_INPUTS, Validator.validateNode),
+            (f, v) => Validator.validateArray(f, v, (f, v) => Validator.validateTuple(f, v, [
+                Validator.validateNode,
+                (f, v) => Validator.validateArray(f, v, Validator.validateIndex),
+            ])),
+        ]);
+    }
+
+    static getGroups() {
+        return GROUPS;
+    }
+
+    getSpec() {
+        return [this.logic, this.inputs, this.terms];
+    }
+
+    getAllNodes() {
+        return [...this.inputs, ...this.getOutputNodes()];
+    }
+
+    getInputNodes() {
+        return this.inputs;
+    }
+
+    getOutputNodes() {
+        return this.terms.map(([output]) => output);
+    }
+
+    getGroupNodes(group) {
+        return {
+            input: this.inputs,
+            output: this.getOutputNodes(),
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.inputs = this.inputs.map(n => map[n]);
+        this.terms = this.terms.map(([output, mask]) => [map[output], mask]);
+    }
+}
@@ -41,6 +41,14 @@ export class Transistor {
         return [this.gate, this.channel[0], this.channel[1]];
     }
 
+    getInputNodes() {
+        return [this.gate, ...this.channel];
+    }
+
+    getOutputNodes() {
+        return this.channel;
+    }
+
     getGroupNodes(group) {
         return {
             gate: [this.gate],
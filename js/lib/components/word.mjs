@@ -0,0 +1,114 @@
+import { Util } from '../util.mjs';
+import { Validator } from '../validator.mjs';
+
+const MAX_BITS = 16;
+const MAX_WRITES = 2;
+const MAX_READS = 2;
+
+const GROUPS = [
+    'input',
+    'output',
+    'write',
+    'read',
+];
+
+const TYPES = {
+    d_latch: {},
+};
+
+export class Word {
+
+    constructor(idx, logic, type, inputs, outputs, writes, reads) {
+        this.idx = idx;
+        this.logic = logic;
+        this.type = type;
+        this.inputs = inputs;
+        this.outputs = outputs;
+        this.writes = writes || [];
+        this.reads = reads || [];
+
+        if (TYPES[type] === undefined) {
+            throw new Error(`Unknown word type '${type}'`);
+        }
+
+        if (inputs.length !== outputs.length) {
+            throw new Error('Words must have one output node per input node');
+        }
+
+        if (inputs.length > MAX_BITS) {
+            throw new Error(`Words with more than ${MAX_BITS} bits are not supported`);
+        }
+
+        if (this.writes.length > MAX_WRITES || this.reads.length > MAX_READS) {
+            throw new Error(`Words may have at most ${MAX_WRITES} write and ${MAX_READS} read nodes`);
+        }
+    }
+
+    static getMaxBits() {
+        return MAX_BITS;
+    }
+
+    static compare(a, b) {
+        return a.logic.localeCompare(b.logic) ||
+            a.type.localeCompare(b.type) ||
+            Util.compareArrays(a.inputs, b.inputs) ||
+            Util.compareArrays(a.outputs, b.outputs) ||
+            Util.compareArrays(a.writes, b.writes) ||
+            Util.compareArrays(a.reads, b.reads);
+    }
+
+    static compatible(a, b) {
+        return a.logic === b.logic &&
+            a.type === b.type &&
+            a.inputs.length === b.inputs.length &&
+            a.writes.length === b.writes.length &&
+            a.reads.length === b.reads.length;
+    }
+
+    static validateSpec(field, val) {
+        return Validator.validateTuple(field, val, [
+            (f, v) => Validator.validateEnum(f, v, ['nmos', 'pmos', 'cmos', 'ttl']),
+            (f, v) => Validator.validateEnum(f, v, Object.keys(TYPES)),
+            (f, v) => Validator.validateArray(f, v, 1, MAX_BITS, Validator.validateNode),
+            (f, v) => Validator.validateArray(f, v, 1, MAX_BITS, Validator.validateNode),
+            (f, v) => Validator.validateArray(f, v, 0, MAX_WRITES, Validator.validateNode),
+            (f, v) => Validator.validateArray(f, v, 0, MAX_READS, Validator.validateNode),
+        ]);
+    }
+
+    static getGroups() {
+        return GROUPS;
+    }
+
+    getSpec() {
+        return [this.logic, this.type, this.inputs, this.outputs, this.writes, this.reads];
+    }
+
+    getAllNodes() {
+        return [...this.inputs, ...this.outputs, ...this.writes, ...this.reads];
+    }
+
+    getInputNodes() {
+        return [...this.inputs, ...this.writes, ...this.reads];
+    }
+
+    getOutputNodes() {
+        return this.outputs;
+    }
+
+    getGroupNodes(group) {
+        return {
+            input: this.inputs,
+            output: this.outputs,
+            write: this.writes,
+            read: this.reads,
+        }[group];
+    }
+
+    remapNodes(map) {
+        this.inputs = this.inputs.map(n => map[n]);
+        this.outputs = this.outputs.map(n => map[n]);
+        this.writes = this.writes.map(n => map[n]);
+        this.reads = this.reads.map(n => map[n]);
+    }
+}
@@ -71,6 +71,20 @@ export class Generator {
                         throw new TypeError(`Unsupported cell type '${type}'`);
                 }
             },
+            getBitEnum: (bit) => {
+                switch (bit) {
+                    case 0:
+                        return 'BIT_ZERO';
+                    case 1:
+                        return 'BIT_ONE';
+                    case -1:
+                        return 'BIT_Z';
+                    case -2:
+                        return 'BIT_META';
+                    default:
+                        throw new TypeError(`Unsupported bit value '${bit}'`);
+                }
+            },
             getLogicEnum: (logic) => {
                 switch (logic) {
                     case 'nmos':
@@ -261,7 +275,35 @@ function generateC_device_c(C, spec, layout) {
             layout.functions.length ? `${C.device_caps}_FUNCTION_DEFS,` : 'NULL,',
             `${C.device_caps}_FUNCTION_COUNT,`,
             layout.cells.length ? `${C.device_caps}_CELL_DEFS,` : 'NULL,',
-            `${C.device_caps}_CELL_COUNT`,
+            `${C.device_caps}_CELL_COUNT,`,
+            layout.words.length ? `${C.device_caps}_WORD_DEFS,` : 'NULL,',
+            `${C.device_caps}_WORD_COUNT,`,
+            layout.plas.length ? `${C.device_caps}_PLA_DEFS,` : 'NULL,',
+            `${C.device_caps}_PLA_COUNT,`,
+            layout.plas.length ? `${C.device_caps}_PLA_TERM_DEFS,` : 'NULL,',
+            `${C.device_caps}_PLA_TERM_COUNT,`,
+            layout.chains.length ? `${C.device_caps}_CHAIN_DEFS,` : 'NULL,',
+            `${C.device_caps}_CHAIN_COUNT,`,
+            layout.chains.length ? `${C.device_caps}_CHAIN_STAGE_DEFS,` : 'NULL,',
+            `${C.device_caps}_CHAIN_STAGE_COUNT,`,
+            layout.passes.length ? `${C.device_caps}_PASS_DEFS,` : 'NULL,',
+            `${C.device_caps}_PASS_COUNT,`,
+            layout.buses.length ? `${C.device_caps}_BUS_DEFS,` : 'NULL,',
+            `${C.device_caps}_BUS_COUNT,`,
+            layout.clocks.length ? `${C.device_caps}_CLOCK_DEFS,` : 'NULL,',
+            `${C.device_caps}_CLOCK_COUNT,`,
+            layout.clocks.length ? `${C.device_caps}_CLOCK_OUTPUT_DEFS,` : 'NULL,',
+            `${C.device_caps}_CLOCK_OUTPUT_COUNT,`,
+            layout.clocks.length ? `${C.device_caps}_CLOCK_STEP_DEFS,` : 'NULL,',
+            `${C.device_caps}_CLOCK_STEP_COUNT,`,
+            layout.clocks.length ? `${C.device_caps}_CLOCK_CHANGE_DEFS,` : 'NULL,',
+            `${C.device_caps}_CLOCK_CHANGE_COUNT,`,
+            layout.cccs.length ? `${C.device_caps}_CCC_DEFS,` : 'NULL,',
+            `${C.device_caps}_CCC_COUNT,`,
+            layout.cccs.length ? `${C.device_caps}_CCC_NODES,` : 'NULL,',
+            `${C.device_caps}_CCC_NODE_COUNT,`,
+            layout.cccs.length ? `${C.device_caps}_CCC_TRANSISTORS,` : 'NULL,',
+            `${C.device_caps}_CCC_TRANSISTOR_COUNT`,
         ]),
         tab(1, '};'),
         '',
@@ -417,6 +459,12 @@ function generateC_adapter_h(C, spec, layout) {
 }
 
 function generateC_adapter_c(C, spec, layout) {
+    const pin_groups = [16, 8, 1].filter(bits => (
+        layout.pins.filter(p => p.bits === bits && p.readable).length
+    ));
+
+    const pin_base = bits => (bits === 1 ? '10' : `${C.device_caps}_PIN_${bits}_MAP[i].base`);
+
     return join ([
         '#include "adapter.h"',
         '',
@@ -524,6 +572,17 @@ function generateC_adapter_c(C, spec, layout) {
         'static value_t adapter_instance_read_mem(const void * instance, unsigned int addr);',
         'static void adapter_instance_write_mem(' +
             'void * instance, unsigned int addr, unsigned int data);',
+        'static void adapter_instance_read_mem_block(const void * instance, unsigned int addr,',
+        '                                            unsigned char * data, size_t count);',
+        'static void adapter_instance_write_mem_block(void * instance, unsigned int addr,',
+        '                                             const unsigned char * data, size_t count);',
+        'static const unsigned char * adapter_instance_get_mem(' +
+            'const void * instance, unsigned int addr,',
+        '                                                      size_t * count);',
+        'static int adapter_instance_resolve_pin(const void * instance, const char * pin);',
+        'static value_t adapter_instance_read_pin_handle(const void * instance, int pin);',
+        'static void adapter_instance_write_pin_handle(' +
+            'void * instance, int pin, unsigned int data);',
         '',
         comment('Adapter singleton', 2),
         '',
@@ -544,6 +603,12 @@ function generateC_adapter_c(C, spec, layout) {
             'adapter_instance_write_pin,',
             'adapter_instance_read_mem,',
             'adapter_instance_write_mem,',
+            'adapter_instance_read_mem_block,',
+            'adapter_instance_write_mem_block,',
+            'adapter_instance_get_mem,',
+            'adapter_instance_resolve_pin,',
+            'adapter_instance_read_pin_handle,',
+            'adapter_instance_write_pin_handle,',
         ]),
         '};',
         '',
@@ -788,6 +853,89 @@ function generateC_adapter_c(C, spec, layout) {
         ] : []),
         '}',
         '',
+        'int adapter_instance_resolve_pin(const void * instance, const char * pin) {',
+        ...(pin_groups.length ? [
+            tab(1, 'size_t offset = 0;'),
+            tab(1, 'size_t i;'),
+            '',
+        ] : []),
+        ...pin_groups.map((bits, g) => [
+            tab(1, `for (i = 0; i < ${C.device_caps}_PIN_${bits}_COUNT; i++) {`),
+            tab(2, `if (strcmp(pin, ${C.device_caps}_PIN_${bits}_MAP[i].pin) == 0) {`),
+            tab(3, 'return (int)(offset + i);'),
+            tab(2, '}'),
+            tab(1, '}'),
+            '',
+            ...(g < pin_groups.length - 1 ? [
+                tab(1, `offset += ${C.device_caps}_PIN_${bits}_COUNT;`),
+                '',
+            ] : []),
+        ].join("\n")),
+        tab(1, 'return -1;'),
+        '}',
+        '',
+        'value_t adapter_instance_read_pin_handle(const void * instance, int pin) {',
+        tab(1, [
+            `const ${C.device}_instance_t * ${C.device}_instance = `
+                + `(${C.device}_instance_t *)instance;`,
+            '',
+            'value_t val = { 0, 0, 0 };',
+            'size_t i = (size_t)pin;',
+            '',
+            'if (pin < 0) {',
+            tab(1, 'return val;'),
+            '}',
+            '',
+        ]),
+        ...pin_groups.map((bits, g) => [
+            tab(1, `if (i < ${C.device_caps}_PIN_${bits}_COUNT) {`),
+            tab(2, `if (${C.device_caps}_PIN_${bits}_MAP[i].read_func != NULL) {`),
+            tab(3, [
+                `val.data = ${C.device_caps}_PIN_${bits}_MAP[i].read_func(` +
+                    `${C.device}_instance->${C.device});`,
+                `val.bits = ${bits};`,
+                `val.base = ${pin_base(bits)};`,
+            ]),
+            tab(2, '}'),
+            '',
+            tab(2, 'return val;'),
+            tab(1, '}'),
+            '',
+            ...(g < pin_groups.length - 1 ? [
+                tab(1, `i -= ${C.device_caps}_PIN_${bits}_COUNT;`),
+                '',
+            ] : []),
+        ].join("\n")),
+        tab(1, 'return val;'),
+        '}',
+        '',
+        'void adapter_instance_write_pin_handle(void * instance, int pin, unsigned int data) {',
+        tab(1, [
+            `${C.device}_instance_t * ${C.device}_instance = (${C.device}_instance_t *)instance;`,
+            'size_t i = (size_t)pin;',
+            '',
+            'if (pin < 0) {',
+            tab(1, 'return;'),
+            '}',
+            '',
+        ]),
+        ...pin_groups.map((bits, g) => [
+            tab(1, `if (i < ${C.device_caps}_PIN_${bits}_COUNT) {`),
+            tab(2, `if (${C.device_caps}_PIN_${bits}_MAP[i].write_func != NULL) {`),
+            tab(3, `${C.device_caps}_PIN_${bits}_MAP[i].write_func(` +
+                `${C.device}_instance->${C.device}, data, true);`),
+            tab(2, '}'),
+            '',
+            tab(2, 'return;'),
+            tab(1, '}'),
+            ...(g < pin_groups.length - 1 ? [
+                '',
+                tab(1, `i -= ${C.device_caps}_PIN_${bits}_COUNT;`),
+                '',
+            ] : []),
+        ].join("\n")),
+        '}',
+        '',
         'value_t adapter_instance_read_mem(const void * instance, unsigned int addr) {',
         tab(1, [
             `const ${C.device}_instance_t * ${C.device}_instance = `
@@ -810,6 +958,38 @@ function generateC_adapter_c(C, spec, layout) {
             `${C.device}_memory_write(${C.device}_instance->memory, addr, data);`,
         ]),
         '}',
+        '',
+        'void adapter_instance_read_mem_block(const void * instance, unsigned int addr,',
+        '                                     unsigned char * data, size_t count) {',
+        tab(1, [
+            `const ${C.device}_instance_t * ${C.device}_instance = `
+                + `(${C.device}_instance_t *)instance;`,
+            '',
+            `${C.device}_memory_read_block(${C.device}_instance->memory, addr, data, count);`,
+        ]),
+        '}',
+        '',
+        'void adapter_instance_write_mem_block(void * instance, unsigned int addr,',
+        '                                      const unsigned char * data, size_t count) {',
+        tab(1, [
+            `${C.device}_instance_t * ${C.device}_instance = (${C.device}_instance_t *)instance;`,
+            '',
+            `${C.device}_memory_write_block(${C.device}_instance->memory, addr, data, count);`,
+        ]),
+        '}',
+        '',
+        'const unsigned char * adapter_instance_get_mem(const void * instance, unsigned int addr,',
+        '                                               size_t * count) {',
+        tab(1, spec.memory.word === 8 ? [
+            `const ${C.device}_instance_t * ${C.device}_instance = `
+                + `(${C.device}_instance_t *)instance;`,
+            '',
+            `return ${C.device}_memory_data(${C.device}_instance->memory, addr, count);`,
+        ] : [
+            comment('Multi-byte words are stored in host byte order, so they cannot be exposed'),
+            'return NULL;',
+        ]),
+        '}',
     ]);
 }
 
@@ -826,6 +1006,8 @@ function generateC_memory_h(C, spec, layout) {
         `#ifndef ${include_guard}`,
         `#define ${include_guard}`,
         '',
+        '#include <stddef.h>',
+        '',
         comment('Constants', 2),
         '',
         `enum { ${C.device_caps}_MEMORY_ADDR_WIDTH = ${spec.memory.address} };`,
@@ -849,16 +1031,38 @@ function generateC_memory_h(C, spec, layout) {
             `const ${C.device}_memory_t * memory, ${C.device}_addr_t addr);`,
         `void ${C.device}_memory_write(` +
             `${C.device}_memory_t * memory, ${C.device}_addr_t addr, ${C.device}_word_t word);`,
+        `void ${C.device}_memory_read_block(` +
+            `const ${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+        ' '.repeat(`void ${C.device}_memory_read_block(`.length) +
+            'unsigned char * data, size_t count);',
+        `void ${C.device}_memory_write_block(` +
+            `${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+        ' '.repeat(`void ${C.device}_memory_write_block(`.length) +
+            'const unsigned char * data, size_t count);',
+        ...(spec.memory.word === 8 ? [
+            `const unsigned char * ${C.device}_memory_data(` +
+                `const ${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+            ' '.repeat(`const unsigned char * ${C.device}_memory_data(`.length) +
+                'size_t * count);',
+        ] : []),
         '',
         `#endif /* ${include_guard} */`,
     ]);
 }
 
 function generateC_memory_c(C, spec, layout) {
+    const word_shift = Math.log2(spec.memory.word / 8);
+    const word_bytes = spec.memory.word / 8;
+
+    const read_head = `void ${C.device}_memory_read_block(`;
+    const block_head = `void ${C.device}_memory_write_block(`;
+    const data_head = `const unsigned char * ${C.device}_memory_data(`;
+
     return join([
         '#include "memory.h"',
         '',
         '#include <stdlib.h>',
+        '#include <string.h>',
         '',
         `${C.device}_memory_t * ${C.device}_memory_init() {`,
         tab(1, `return (${C.device}_memory_t *)calloc(1, sizeof(${C.device}_memory_t));`),
@@ -877,6 +1081,89 @@ function generateC_memory_c(C, spec, layout) {
             `${C.device}_memory_t * memory, ${C.device}_addr_t addr, ${C.device}_word_t word) {`,
         tab(1, `memory->memory[addr >> ${Math.log2(spec.memory.word / 8)}] = word;`),
         '}',
+        '',
+        read_head + `const ${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+        ' '.repeat(read_head.length) + 'unsigned char * data, size_t count) {',
+        ...(word_bytes === 1 ? [
+            tab(1, 'size_t head;'),
+            '',
+            tab(1, comment('Copy up to the end of the address space, then wrap around')),
+            tab(1, 'while (count > 0) {'),
+            tab(2, [
+                `head = ${C.device_caps}_MEMORY_WORD_COUNT - (addr >> ${word_shift});`,
+                'head = count < head ? count : head;',
+                '',
+                `memcpy(data, &memory->memory[addr >> ${word_shift}], head);`,
+                '',
+                'addr = 0;',
+                'data += head;',
+                'count -= head;',
+            ]),
+            tab(1, '}'),
+        ] : [
+            tab(1, 'size_t i, b;'),
+            '',
+            tab(1, comment('Split each word into its bytes, wrapping around the address space')),
+            tab(1, 'for (i = 0; i < count; i++) {'),
+            tab(2, [
+                `${C.device}_word_t word = memory->memory[((addr >> ${word_shift}) + i) % ` +
+                    `${C.device_caps}_MEMORY_WORD_COUNT];`,
+                '',
+                `for (b = 0; b < ${word_bytes}; b++) {`,
+                tab(1, `data[i * ${word_bytes} + b] = (unsigned char)(word >> (8 * b));`),
+                '}',
+            ]),
+            tab(1, '}'),
+        ]),
+        '}',
+        '',
+        block_head + `${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+        ' '.repeat(block_head.length) + 'const unsigned char * data, size_t count) {',
+        ...(word_bytes === 1 ? [
+            tab(1, 'size_t head;'),
+            '',
+            tab(1, comment('Copy up to the end of the address space, then wrap around')),
+            tab(1, 'while (count > 0) {'),
+            tab(2, [
+                `head = ${C.device_caps}_MEMORY_WORD_COUNT - (addr >> ${word_shift});`,
+                'head = count < head ? count : head;',
+                '',
+                `memcpy(&memory->memory[addr >> ${word_shift}], data, head);`,
+                '',
+                'addr = 0;',
+                'data += head;',
+                'count -= head;',
+            ]),
+            tab(1, '}'),
+        ] : [
+            tab(1, 'size_t i, b;'),
+            '',
+            tab(1, comment('Assemble each word from its bytes, wrapping around the address space')),
+            tab(1, 'for (i = 0; i < count; i++) {'),
+            tab(2, [
+                `${C.device}_word_t word = 0;`,
+                '',
+                `for (b = 0; b < ${word_bytes}; b++) {`,
+                tab(1, `word |= (${C.device}_word_t)data[i * ${word_bytes} + b] << (8 * b);`),
+                '}',
+                '',
+                `memory->memory[((addr >> ${word_shift}) + i) % ` +
+                    `${C.device_caps}_MEMORY_WORD_COUNT] = word;`,
+            ]),
+            tab(1, '}'),
+        ]),
+        '}',
+        ...(word_bytes === 1 ? [
+            '',
+            data_head + `const ${C.device}_memory_t * memory, ${C.device}_addr_t addr,`,
+            ' '.repeat(data_head.length) + 'size_t * count) {',
+            tab(1, [
+                `*count = ${C.device_caps}_MEMORY_WORD_COUNT - (addr >> ${word_shift});`,
+                '',
+                `return &memory->memory[addr >> ${word_shift}];`,
+            ]),
+            '}',
+        ] : []),
     ]);
 }
 
@@ -915,13 +1202,16 @@ function generateC_layout_h(C, spec, layout) {
 
     const syms_width = Math.max(...syms.map(p => p.sym.length));
 
-    let funcIds = Object.fromEntries(layout.functions.map(f => f.code)
+    // Chain stages share the function table with standalone functions
+    const stageFuncs = [].concat(...layout.chains.map(ch => ch.stages));
+
+    let funcIds = Object.fromEntries([...layout.functions, ...stageFuncs].map(f => f.code)
                                      .filter((v, i, a) => a.indexOf(v) === i)
                                      .map((f, i) => [f, i]));
 
     let funcs = {};
 
-    layout.functions.forEach(f => {
+    [...layout.functions, ...stageFuncs].forEach(f => {
         funcs[f.code] = {
             name: `__${C.device}_func_${funcIds[f.code]}`,
             params: f.params,
@@ -929,6 +1219,48 @@ function generateC_layout_h(C, spec, layout) {
         };
     });
 
+    // Offsets of each PLA into the flat term list
+    const plas = layout.plas.map((pla, i, a) => ({
+        pla,
+        termsStart: a.slice(0, i).reduce((sum, p) => sum + p.terms.length, 0),
+    }));
+
+    // Offsets of each chain into the flat stage list
+    const chains = layout.chains.map((chain, i, a) => ({
+        chain,
+        stagesStart: a.slice(0, i).reduce((sum, ch) => sum + ch.stages.length, 0),
+    }));
+
+    // Offsets of each clock tree into the flat output and step lists, and of each step into the change list.
+    // Changes refer to outputs by their index in the flat output list.
+    const clockOutputs = [], clockSteps = [], clockChanges = [];
+
+    const clocks = layout.clocks.map(clock => {
+        const outputsStart = clockOutputs.length;
+
+        clockOutputs.push(...clock.outputs);
+
+        const edges = clock.edges.map(steps => {
+            const stepsStart = clockSteps.length;
+
+            steps.forEach(changes => {
+                clockSteps.push({ changesStart: clockChanges.length, changes });
+                clockChanges.push(...changes.map(([k, bit]) => [outputsStart + k, bit]));
+            });
+
+            return { stepsStart, steps };
+        });
+
+        return { clock, outputsStart, edges };
+    });
+
+    // Offsets of each CCC into the flat node and transistor lists
+    const cccs = layout.cccs.map((ccc, i, a) => ({
+        ...ccc,
+        nodesStart: a.slice(0, i).reduce((sum, c) => sum + c.nodes.length, 0),
+        transistorsStart: a.slice(0, i).reduce((sum, c) => sum + c.transistors.length, 0),
+    }));
+
     return join ([
         `#ifndef ${include_guard}`,
         `#define ${include_guard}`,
@@ -980,8 +1312,22 @@ function generateC_layout_h(C, spec, layout) {
         `const size_t ${C.device_caps}_BUFFER_COUNT = ${layout.counts.buffers};`,
         `const size_t ${C.device_caps}_FUNCTION_COUNT = ${layout.counts.functions};`,
         `const size_t ${C.device_caps}_CELL_COUNT = ${layout.counts.cells};`,
-        '',
-        ...(layout.functions.length ? [
+        `const size_t ${C.device_caps}_WORD_COUNT = ${layout.counts.words};`,
+        `const size_t ${C.device_caps}_PLA_COUNT = ${layout.counts.plas};`,
+        `const size_t ${C.device_caps}_PLA_TERM_COUNT = ${layout.plas.reduce((sum, p) => sum + p.terms.length, 0)};`,
+        `const size_t ${C.device_caps}_CHAIN_COUNT = ${layout.counts.chains};`,
+        `const size_t ${C.device_caps}_CHAIN_STAGE_COUNT = ${stageFuncs.length};`,
+        `const size_t ${C.device_caps}_PASS_COUNT = ${layout.counts.passes};`,
+        `const size_t ${C.device_caps}_BUS_COUNT = ${layout.counts.buses};`,
+        `const size_t ${C.device_caps}_CLOCK_COUNT = ${layout.counts.clocks};`,
+        `const size_t ${C.device_caps}_CLOCK_OUTPUT_COUNT = ${clockOutputs.length};`,
+        `const size_t ${C.device_caps}_CLOCK_STEP_COUNT = ${clockSteps.length};`,
+        `const size_t ${C.device_caps}_CLOCK_CHANGE_COUNT = ${clockChanges.length};`,
+        `const size_t ${C.device_caps}_CCC_COUNT = ${layout.counts.cccs};`,
+        `const size_t ${C.device_caps}_CCC_NODE_COUNT = ${cccs.reduce((sum, c) => sum + c.nodes.length, 0)};`,
+        `const size_t ${C.device_caps}_CCC_TRANSISTOR_COUNT = ${cccs.reduce((sum, c) => sum + c.transistors.length, 0)};`,
+        '',
+        ...(Object.keys(funcs).length ? [
             comment('Function definitions', 2),
             '',
             ...Object.values(funcs).map(f => [
@@ -1042,6 +1388,111 @@ function generateC_layout_h(C, spec, layout) {
             '};',
             '',
         ] : []),
+        ...(layout.words.length ? [
+            `const word_t ${C.device_caps}_WORD_DEFS[] = {`,
+            tab(1, layout.words.map(w => (
+                '{' +
+                    `${C.getLogicEnum(w.logic)}, ` +
+                    `${C.getCellEnum(w.type)}, ` +
+                    `{${w.inputs.join(', ')}}, {${w.outputs.join(', ')}}, ${w.inputs.length}, ` +
+                    `{${w.writes.length ? w.writes.join(', ') : 0}}, ${w.writes.length}, ` +
+                    `{${w.reads.length ? w.reads.join(', ') : 0}}, ${w.reads.length}}`
+            )).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(plas.length ? [
+            `const pla_t ${C.device_caps}_PLA_DEFS[] = {`,
+            tab(1, plas.map(({ pla, termsStart }) => (
+                `{${C.getLogicEnum(pla.logic)}, ` +
+                    `{${pla.inputs.join(', ')}}, ${pla.inputs.length}, ` +
+                    `${termsStart}, ${pla.terms.length}}`
+            )).join(",\n")),
+            '};',
+            '',
+            `const pla_term_t ${C.device_caps}_PLA_TERM_DEFS[] = {`,
+            tab(1, [].concat(...layout.plas.map(pla => pla.terms.map(([output, mask]) => (
+                `{0x${mask.reduce((word, i) => (word | (1 << i)) >>> 0, 0).toString(16).padStart(8, '0')}UL, ${output}}`
+            )))).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(chains.length ? [
+            `const chain_t ${C.device_caps}_CHAIN_DEFS[] = {`,
+            tab(1, chains.map(({ chain, stagesStart }) => `{${stagesStart}, ${chain.stages.length}}`).join(",\n")),
+            '};',
+            '',
+            `const function_t ${C.device_caps}_CHAIN_STAGE_DEFS[] = {`,
+            tab(1, stageFuncs.map(f => (
+                `{${C.getLogicEnum(f.logic)}, ${funcs[f.code].name}, ` +
+                    '{' + f.inputs.join(', ') + '}, ' +
+                    `${f.inputs.length}, ` +
+                    `${f.output}}`
+            )).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(layout.passes.length ? [
+            `const pass_t ${C.device_caps}_PASS_DEFS[] = {`,
+            tab(1, layout.passes.map(p => (
+                `{${C.getTransistorEnum(p.type)}, ${p.gate}, ${p.input}, ${p.output}}`
+            )).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(layout.buses.length ? [
+            `const bus_t ${C.device_caps}_BUS_DEFS[] = {`,
+            tab(1, layout.buses.map(b => (
+                `{${C.getTransistorEnum(b.type)}, ${b.precharge}, ` +
+                    '{' + b.discharges.join(', ') + '}, ' +
+                    `${b.discharges.length}, ` +
+                    `${b.output}}`
+            )).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(clocks.length ? [
+            `const clock_tree_t ${C.device_caps}_CLOCK_DEFS[] = {`,
+            tab(1, clocks.map(({ clock, outputsStart, edges }) => (
+                `{${clock.input}, ${outputsStart}, ${clock.outputs.length}, ` +
+                    `{${edges.map(e => e.stepsStart).join(', ')}}, ` +
+                    `{${edges.map(e => e.steps.length).join(', ')}}}`
+            )).join(",\n")),
+            '};',
+            '',
+            `const clock_output_t ${C.device_caps}_CLOCK_OUTPUT_DEFS[] = {`,
+            tab(1, clockOutputs.map(o => (
+                `{${C.getLogicEnum(o.logic)}, ${o.output}, ${C.getBitEnum(o.low)}, ${C.getBitEnum(o.high)}}`
+            )).join(",\n")),
+            '};',
+            '',
+            `const clock_step_t ${C.device_caps}_CLOCK_STEP_DEFS[] = {`,
+            tab(1, clockSteps.map(s => `{${s.changesStart}, ${s.changes.length}}`).join(",\n")),
+            '};',
+            '',
+            `const clock_change_t ${C.device_caps}_CLOCK_CHANGE_DEFS[] = {`,
+            tab(1, clockChanges.map(([k, bit]) => `{${k}, ${C.getBitEnum(bit)}}`).join(",\n")),
+            '};',
+            '',
+        ] : []),
+        ...(cccs.length ? [
+            comment('Channel-connected components', 2),
+            '',
+            `const ccc_t ${C.device_caps}_CCC_DEFS[] = {`,
+            tab(1, cccs.map(c => (
+                `{${c.nodesStart}, ${c.nodes.length}, ${c.transistorsStart}, ${c.transistors.length}}`
+            )).join(",\n")),
+            '};',
+            '',
+            `const nx_t ${C.device_caps}_CCC_NODES[] = {`,
+            tab(1, cccs.map(c => c.nodes.join(', ')).join(",\n")),
+            '};',
+            '',
+            `const tx_t ${C.device_caps}_CCC_TRANSISTORS[] = {`,
+            tab(1, cccs.map(c => c.transistors.join(', ')).join(",\n")),
+            '};',
+            '',
+        ] : []),
         `#endif /* ${include_guard} */`,
     ]);
 }
@@ -2,6 +2,19 @@ import { Pin } from './pin.mjs';
 import { Components } from './components.mjs';
 import { State } from './layout/state.mjs';
 import { Cache } from './layout/cache.mjs';
+import { Candidates } from './layout/candidates.mjs';
+import { Matcher } from './layout/matcher.mjs';
+import { Pool } from './layout/pool.mjs';
+import { Order } from './layout/order.mjs';
+import { Constants } from './layout/constants.mjs';
+import { Buffers } from './layout/buffers.mjs';
+import { Partition } from './layout/partition.mjs';
+import { Decoder } from './layout/decoder.mjs';
+import { Registers } from './layout/registers.mjs';
+import { Chains } from './layout/chains.mjs';
+import { Passes } from './layout/passes.mjs';
+import { Buses } from './layout/buses.mjs';
+import { Clocks } from './layout/clocks.mjs';
 
 export class Layout {
 
@@ -67,25 +80,76 @@ export class Layout {
         this.components.addComponents('buffer', spec.buffers);
         this.components.addComponents('function', spec.functions);
         this.components.addComponents('cell', spec.cells);
+        this.components.addComponents('pla', spec.plas);
+        this.components.addComponents('word', spec.words);
+        this.components.addComponents('chain', spec.chains);
+        this.components.addComponents('pass', spec.passes);
+        this.components.addComponents('bus', spec.buses);
+        this.components.addComponents('clock', spec.clocks);
+
+        // Estimated runtime cost after each step, if a profile was given
+        const cost = options.cost ? options.cost : null;
+
+        if (cost) {
+            cost.snapshot('netlist', this);
+        }
 
         // --- Reduce components ---
 
         if (options.reduceCircuits) {
-            this.circuits = spec.circuits
-                .filter(c => c.enabled && !(c.limit <= 0))
-                .map(c => new Layout(c, {}));
+            this.circuits = Layout.buildCircuits(spec);
+
+            // Evaluate anchor candidates ahead of the search in worker threads
+            const pool = options.jobs > 1 ? new Pool(this, spec, options.jobs) : null;
+
+            // Instances reduced per circuit
+            this.reductions = [];
 
-            this.circuits.forEach(circuit => {
+            // Reductions cached by a previous compile
+            const journal = options.journal ? options.journal : null;
+
+            this.circuits.forEach((circuit, idx) => {
                 let limit = circuit.spec.limit ? circuit.spec.limit : Number.MAX_SAFE_INTEGER,
                     count = 0;
 
                 process.stdout.write(`Reducing circuit '${circuit.spec.id}'...`);
 
+                // Replay cached reductions if neither the device nor any circuit up to this one changed
+                const key = journal ? journal.next(circuit) : null,
+                      cached = journal ? journal.getReductions(key) : null;
+
+                if (cached) {
+                    if (pool) {
+                        pool.begin(idx, circuit);
+                    }
+
+                    cached.forEach(state => this.commitCircuit(circuit, state, pool));
+
+                    this.reductions.push(cached.length);
+
+                    if (cost) {
+                        cost.snapshot(circuit.spec.id, this);
+                    }
+
+                    console.log(`done with ${cached.length} (cached)`);
+                    return;
+                }
+
                 // Cache known mis-matches
                 let cache = new Cache();
 
+                // Index device components that can anchor a match
+                let candidates = new Candidates(this, circuit, cache);
+
+                if (pool) {
+                    pool.begin(idx, circuit, candidates.getType(), candidates.getIndex());
+                }
+
                 // Iteratively reduce one circuit instance at a time
-                while (count < limit && this.reduceCircuit(circuit, cache)) {
+                let states = [], state;
+
+                while (count < limit && (state = this.reduceCircuit(circuit, cache, candidates, pool))) {
+                    states.push(state);
                     count++;
 
                     if (count % 10 === 0) {
@@ -93,13 +157,153 @@ export class Layout {
                     }
                 }
 
+                if (journal) {
+                    journal.setReductions(key, circuit, states);
+                }
+
+                this.reductions.push(count);
+
+                if (cost) {
+                    cost.snapshot(circuit.spec.id, this);
+                }
+
                 console.log(`done with ${count}`);
             });
+
+            if (pool) {
+                pool.close();
+            }
+        }
+
+        // --- Propagate constants ---
+
+        if (options.propagateConstants) {
+            process.stdout.write(`Propagating constants...`);
+
+            this.constants = new Constants(this);
+
+            const counts = this.constants.propagate();
+
+            console.log(`done with ${counts.off + counts.folded + counts.shorted} transistors ` +
+                `(${counts.off} off, ${counts.folded} folded, ${counts.shorted} shorted), ` +
+                `${counts.dead} unread components, ${counts.loads} loads and ${counts.nodes} nodes removed`);
+
+            if (cost) {
+                cost.snapshot('--constants', this);
+            }
+        }
+
+        // --- Collapse buffer chains ---
+
+        if (options.collapseBuffers) {
+            process.stdout.write(`Collapsing buffer chains...`);
+
+            const counts = new Buffers(this).collapse();
+
+            console.log(`done with ${counts.rewired} readers rewired and ${counts.removed} buffers removed, ` +
+                `saving up to ${counts.longest} iterations per half-cycle along one path`);
+
+            if (cost) {
+                cost.snapshot('--buffers', this);
+            }
+        }
+
+        // --- Gather clock tree ---
+
+        if (options.buildClockTree) {
+            const pin = this.pins.find(p => p.id === options.clock && p.type === 'pin' && p.nodes.length === 1);
+
+            if (!pin) {
+                throw new Error(`Clock pin '${options.clock}' not found`);
+            }
+
+            process.stdout.write(`Gathering clock tree...`);
+
+            const counts = new Clocks(this, pin).build();
+
+            console.log(`done with ${counts.nodes} nodes ` +
+                `(${counts.buffers} buffers, ${counts.functions} functions, ${counts.drivers} drivers) over ${counts.steps} steps`);
+
+            if (cost) {
+                cost.snapshot('--clock-tree', this);
+            }
+        }
+
+        // --- Recognize pass transistors ---
+
+        if (options.buildPasses) {
+            process.stdout.write(`Recognizing pass transistors...`);
+
+            const counts = new Passes(this).build();
+
+            console.log(`done with ${counts.passes} pass gates ` +
+                `(${counts.loads} from loads, ${counts.driven} from logic, ${counts.rails} from rails)`);
+
+            if (cost) {
+                cost.snapshot('--passes', this);
+            }
+        }
+
+        // --- Recognize precharged buses ---
+
+        if (options.buildBuses) {
+            process.stdout.write(`Recognizing precharged buses...`);
+
+            const counts = new Buses(this).build();
+
+            console.log(`done with ${counts.buses} buses ` +
+                `(${counts.discharges} discharge inputs, widest ${counts.widest})`);
+
+            if (cost) {
+                cost.snapshot('--buses', this);
+            }
+        }
+
+        // --- Recognize PLAs ---
+
+        if (options.buildPlas) {
+            process.stdout.write(`Recognizing PLAs...`);
+
+            const counts = new Decoder(this).build();
+
+            console.log(`done with ${counts.plas} PLAs of ${counts.terms} terms over ${counts.inputs} inputs`);
+
+            if (cost) {
+                cost.snapshot('--pla', this);
+            }
+        }
+
+        // --- Recognize registers ---
+
+        if (options.buildWords) {
+            process.stdout.write(`Recognizing registers...`);
+
+            const counts = new Registers(this).build();
+
+            console.log(`done with ${counts.words} words of ${counts.bits} bits`);
+
+            if (cost) {
+                cost.snapshot('--words', this);
+            }
+        }
+
+        // --- Recognize chains ---
+
+        if (options.buildChains) {
+            process.stdout.write(`Recognizing chains...`);
+
+            const counts = new Chains(this).build();
+
+            console.log(`done with ${counts.chains} chains of ${counts.stages} stages (longest ${counts.longest})`);
+
+            if (cost) {
+                cost.snapshot('--chains', this);
+            }
         }
 
         // --- Normalize ---
 
-        this.normalizeNodes(options.reduceNodes);
+        this.normalizeNodes(options.reduceNodes, options.orderNodes);
 
         // --- Calculate counts ---
 
@@ -111,6 +315,12 @@ export class Layout {
             buffers: this.components.getCount('buffer'),
             functions: this.components.getCount('function'),
             cells: this.components.getCount('cell'),
+            plas: this.components.getCount('pla'),
+            words: this.components.getCount('word'),
+            chains: this.components.getCount('chain'),
+            passes: this.components.getCount('pass'),
+            buses: this.components.getCount('bus'),
+            clocks: this.components.getCount('clock'),
         };
 
         // --- Extract components ---
@@ -120,183 +330,160 @@ export class Layout {
         this.buffers = this.components.getComponents('buffer');
         this.functions = this.components.getComponents('function');
         this.cells = this.components.getComponents('cell');
+        this.plas = this.components.getComponents('pla');
+        this.words = this.components.getComponents('word');
+        this.chains = this.components.getComponents('chain');
+        this.passes = this.components.getComponents('pass');
+        this.buses = this.components.getComponents('bus');
+        this.clocks = this.components.getComponents('clock');
+
+        // --- Partition nodes ---
+
+        const rails = [this.on, this.off].filter(Boolean).map(p => p.nodes[0]);
+
+        this.cccs = Partition.buildCCCs(this.transistors, rails);
+
+        this.counts.cccs = this.cccs.length;
     }
 
-    reduceCircuit(circuit, cache) {
-        const device = this;
+    static buildCircuits(spec) {
+        return spec.circuits
+            .filter(c => c.enabled && !(c.limit <= 0))
+            .map(c => new Layout(c, {}));
+    }
 
-        // Component matchers
-        function matchNodes(cnx, dnx, state) {
+    hasComponentsAt(type, node) {
+        return Components.getGroups(type).some(group => {
+            return this.components.getIndicesByNode(type, group, node).length > 0;
+        });
+    }
 
-            // Check if nodes are already matched or already in use
-            if (state.doNodesMatch(cnx, dnx)) {
-                return state;
-            }
+    canMatchNodes(circuit, cnx, dnx) {
+        const device = this;
 
-            if (state.doNodesConflict(cnx, dnx)) {
-                return false;
-            }
+        // Fetch pins
+        let cpx = circuit.pinsByNode[cnx],
+            dpx = device.pinsByNode[dnx];
 
-            // Fetch pins
-            let cpx = circuit.pinsByNode[cnx],
-                dpx = device.pinsByNode[dnx];
+        let cpin = cpx === undefined ? null : circuit.pins[cpx],
+            dpin = dpx === undefined ? null : device.pins[dpx];
 
-            let cpin = cpx === undefined ? null : circuit.pins[cpx],
-                dpin = dpx === undefined ? null : device.pins[dpx];
+        // Source-type pins must match
+        if (cpin && cpin.type === 'src' && (!dpin || dpin.mode !== cpin.mode) ||
+            dpin && dpin.type === 'src' && (!cpin || cpin.mode !== dpin.mode)) {
 
-            // Source-type pins must match
-            if (cpin && cpin.type === 'src' && (!dpin || dpin.mode !== cpin.mode) ||
-                dpin && dpin.type === 'src' && (!cpin || cpin.mode !== dpin.mode)) {
+            return false;
+        }
 
-                return false;
-            }
+        // Check if the circuit node is internal
+        const internal = !cpin || (cpin.type !== 'src' && cpin.type !== 'pin');
 
-            // Check if the circuit node is internal
-            const internal = !cpin || (cpin.type !== 'src' && cpin.type !== 'pin');
+        // Device pins may not be internal circuit nodes
+        if (internal && dpin && dpin.type !== 'src') {
+            return false;
+        }
 
-            // Device pins may not be internal circuit nodes
-            if (internal && dpin && dpin.type !== 'src') {
-                return false;
-            }
+        // Compare component counts
+        for (const type of Components.getTypes()) {
+            for (const group of Components.getGroups(type)) {
+                const cxs = circuit.components.getIndicesByNode(type, group, cnx),
+                      dxs = device.components.getIndicesByNode(type, group, dnx);
 
-            // Compare component counts
-            for (const type of Components.getTypes()) {
-                for (const group of Components.getGroups(type)) {
-                    const cxs = circuit.components.getIndicesByNode(type, group, cnx),
-                          dxs = device.components.getIndicesByNode(type, group, dnx);
-
-                    if (internal) {
-                        if (dxs.length !== cxs.length) {
-                            return false;
-                        }
-                    } else {
-                        if (dxs.length < cxs.length) {
-                            return false;
-                        }
+                if (internal) {
+                    if (dxs.length !== cxs.length) {
+                        return false;
                     }
-                }
-            }
-
-            // Update state
-            state = state.copyWithNode(cnx, dnx);
-
-            // Match components
-            for (const type of Components.getTypes()) {
-                for (const group of Components.getGroups(type)) {
-                    const cxs = circuit.components.getIndicesByNode(type, group, cnx),
-                          dxs = device.components.getIndicesByNode(type, group, dnx);
-
-                    if (!cxs.every(cx => {
-                        if (state = findComponent(type, cx, dxs, state)) {
-                            return true;
-                        } else {
-                            return false;
-                        }
-                    })) {
+                } else {
+                    if (dxs.length < cxs.length) {
                         return false;
                     }
                 }
             }
-
-            return state;
         }
 
-        function matchComponents(type, cx, dx, state) {
-
-            // Check if components are either matched or otherwise in use
-            if (state.doComponentsMatch(type, cx, dx)) {
-                return state;
-            }
-
-            if (state.doComponentsConflict(type, cx, dx)) {
-                return false;
-            }
+        return true;
+    }
 
-            // Check component compatibility
-            let cc = circuit.components.getComponent(type, cx),
-                dd = device.components.getComponent(type, dx);
+    reduceCircuit(circuit, cache, candidates, pool) {
 
-            if (!Components.areCompatible(type, cc, dd)) {
-                return false;
-            }
+        // Match all components, seeding the search from indexed anchor candidates
+        const state = pool ?
+            this.matchCircuitParallel(circuit, cache, candidates, pool) :
+            new Matcher(this, circuit, cache).matchCircuit(
+                candidates.getType(), candidates.getIndex(), candidates.getIndices());
 
-            // Match nodes
-            state = state.copyWithComponent(type, cx, dx);
+        if (!state) {
+            return false;
+        }
 
-            for (const group of Components.getGroups(type)) {
-                const cnodes = cc.getGroupNodes(group), dnodes = dd.getGroupNodes(group);
+        const nodes = state.getDeviceNodes();
 
-                if (cnodes.length !== dnodes.length) {
-                    return false;
-                }
+        this.commitCircuit(circuit, state, pool);
 
-                if (cnodes.length === 0) {
-                    continue;
-                } else if (cnodes.length === 1) {
-                    state = matchNodes(cnodes[0], dnodes[0], state)
+        // Re-index anchor candidates around the replaced instance
+        candidates.update(nodes);
 
-                    if (!state) {
-                        return false;
-                    }
-                } else if (cnodes.length === 2) {
-                    let groupState = false;
+        return state;
+    }
 
-                    if ((groupState = matchNodes(cnodes[0], dnodes[0], state)) &&
-                        (groupState = matchNodes(cnodes[1], dnodes[1], groupState))) {
+    commitCircuit(circuit, state, pool) {
+        if (!pool) {
+            this.applyCircuit(circuit, state);
+            return;
+        }
 
-                        state = groupState;
-                    } else if ((groupState = matchNodes(cnodes[0], dnodes[1], state)) &&
-                               (groupState = matchNodes(cnodes[1], dnodes[0], groupState))) {
-                        state = groupState;
-                    } else {
-                        return false;
-                    }
-                } else {
-                    throw new Error('Component groups with greater than 2 nodes not supported');
-                }
-            }
+        // Collect the nodes of reduced components, whose node maps are about to change
+        const removed = [].concat(...Components.getTypes().map(type => {
+            return [].concat(...state.getDeviceComponents(type).map(dx => {
+                return this.components.getComponent(type, dx).getAllNodes();
+            }));
+        }));
 
-            return state;
-        }
+        const added = [].concat(...this.applyCircuit(circuit, state).map(c => c.getAllNodes()));
 
-        // Component finders
-        function findComponent(type, cx, dxs, state) {
-            for (const dx of dxs) {
+        // Mirror the edit in the workers, invalidating results that depended on these nodes
+        pool.publish(state.getTrail(), removed, circuit.type, added);
+    }
 
-                // Short-circuit if this is a known mis-match
-                if (cache.hasMismatch(type, cx, dx, state)) {
-                    continue;
-                }
+    matchCircuitParallel(circuit, cache, candidates, pool) {
+        const type = candidates.getType(),
+              cx = candidates.getIndex(),
+              dxs = candidates.getIndices();
 
-                let newState = matchComponents(type, cx, dx, state);
+        if (type === undefined) {
+            return new Matcher(this, circuit, cache).matchCircuit();
+        }
 
-                if (newState) {
-                    return newState;
-                }
+        // Walk anchor candidates in search order, so the first match is the one a serial search finds
+        for (let i = 0; i < dxs.length; i++) {
+            const dx = dxs[i];
 
-                // Cache this mis-match for future searches
-                cache.cacheMismatch(type, cx, dx, state);
+            if (cache.hasMismatch(type, cx, dx)) {
+                continue;
             }
 
-            return false;
-        }
+            // Use a worker result if the nodes it inspected are unchanged, otherwise search here
+            const result = pool.lookup(dxs, i);
 
-        // Initialize search state
-        let state = new State(Components.getTypes());
+            if (!result) {
+                const { match, state } = new Matcher(this, circuit, cache).matchAnchor(type, cx, dx);
 
-        // Match all components
-        for (const type of Components.getTypes()) {
-            if (!circuit.components.getIndices(type).every(cx => {
-                if (state = findComponent(type, cx, device.components.getIndices(type), state)) {
-                    return true;
-                } else {
-                    return false;
+                if (match) {
+                    return state;
                 }
-            })) {
-                return false;
+            } else if (result.match) {
+                return result.trail ? new State(Components.getTypes()).withTrail(result.trail) : false;
+            } else {
+                cache.cacheMismatch(type, cx, dx, new State(Components.getTypes()));
             }
         }
 
+        return false;
+    }
+
+    applyCircuit(circuit, state) {
+        const device = this;
+
         // Reduce all device components that matched the circuit
         for (const type of Components.getTypes()) {
             device.components.reduceComponents(type, state.getDeviceComponents(type));
@@ -347,14 +534,13 @@ export class Layout {
 
         if (circuit.type === 'reduce') {
             // Reduce components only
-        } else {
-            device.components.addComponents(circuit.type, [args]);
+            return [];
         }
 
-        return true;
+        return device.components.addComponents(circuit.type, [args]).filter(c => !c.__reduce);
     }
 
-    normalizeNodes(reduceNodes) {
+    normalizeNodes(reduceNodes, orderNodes) {
 
         // Find all nodes in use
         const nodes = [].concat(
@@ -364,22 +550,40 @@ export class Layout {
             ...this.components.getAllNodes('buffer'),
             ...this.components.getAllNodes('function'),
             ...this.components.getAllNodes('cell'),
+            ...this.components.getAllNodes('pla'),
+            ...this.components.getAllNodes('word'),
+            ...this.components.getAllNodes('chain'),
+            ...this.components.getAllNodes('pass'),
+            ...this.components.getAllNodes('bus'),
+            ...this.components.getAllNodes('clock'),
         ).filter((v, i, a) => a.indexOf(v) === i).sort((a, b) => a - b);
 
-        if (reduceNodes) {
+        if (orderNodes && orderNodes !== 'none') {
+            process.stdout.write(`Ordering nodes (${orderNodes})...`);
+
+            // Connect nodes that share a component, leaving out the power rails
+            const rails = [this.on, this.off].filter(Boolean).map(p => p.nodes[0]),
+                  edges = this.getNodeEdges(rails);
+
+            const before = Order.measure(edges, Object.fromEntries(nodes.map((node, idx) => [node, idx])));
+
+            // Map nodes to unique indices in locality order
+            this.nodes = Object.fromEntries(
+                Order.orderNodes(nodes, edges, rails, orderNodes === 'rcm').map((node, idx) => [node, idx])
+            );
+
+            this.remapNodes();
+
+            this.locality = { before, after: Order.measure(edges, this.nodes) };
+
+            console.log('done');
+        } else if (reduceNodes) {
             process.stdout.write(`Reducing nodes...`);
 
             // Map nodes to unique indices
             this.nodes = Object.fromEntries(nodes.map((node, idx) => [node, idx]));
 
-            // Replace nodes with unique indices in each component
-            this.pins.forEach(p => { p.nodes = p.nodes.map(n => this.nodes[n]) });
-
-            this.components.getComponents('load').forEach(l => l.remapNodes(this.nodes));
-            this.components.getComponents('transistor').forEach(t => t.remapNodes(this.nodes));
-            this.components.getComponents('buffer').forEach(b => b.remapNodes(this.nodes));
-            this.components.getComponents('function').forEach(f => f.remapNodes(this.nodes));
-            this.components.getComponents('cell').forEach(c => c.remapNodes(this.nodes));
+            this.remapNodes();
 
             console.log('done');
         } else {
@@ -389,6 +593,38 @@ export class Layout {
         }
     }
 
+    remapNodes() {
+
+        // Replace nodes with unique indices in each component
+        this.pins.forEach(p => { p.nodes = p.nodes.map(n => this.nodes[n]) });
+
+        this.components.remapNodes('load', this.nodes);
+        this.components.remapNodes('transistor', this.nodes);
+        this.components.remapNodes('buffer', this.nodes);
+        this.components.remapNodes('function', this.nodes);
+        this.components.remapNodes('cell', this.nodes);
+        this.components.remapNodes('pla', this.nodes);
+        this.components.remapNodes('word', this.nodes);
+        this.components.remapNodes('chain', this.nodes);
+        this.components.remapNodes('pass', this.nodes);
+        this.components.remapNodes('bus', this.nodes);
+        this.components.remapNodes('clock', this.nodes);
+    }
+
+    getNodeEdges(rails) {
+        const edges = [];
+
+        Components.getTypes().forEach(type => {
+            this.components.getComponents(type).forEach(c => {
+                const nodes = c.getAllNodes().filter((n, i, a) => a.indexOf(n) === i && !rails.includes(n));
+
+                nodes.forEach((a, i) => nodes.slice(i + 1).forEach(b => edges.push([a, b])));
+            });
+        });
+
+        return edges;
+    }
+
     printInfo() {
         console.log(`Nodes:       ${this.counts.nodes}`);
         console.log(`Pins:        ${this.counts.pins}`);
@@ -397,6 +633,32 @@ export class Layout {
         console.log(`Buffers:     ${this.counts.buffers}`);
         console.log(`Functions:   ${this.counts.functions}`);
         console.log(`Cells:       ${this.counts.cells}`);
+        console.log(`PLAs:        ${this.counts.plas}`);
+        console.log(`Words:       ${this.counts.words}`);
+        console.log(`Chains:      ${this.counts.chains}`);
+        console.log(`Passes:      ${this.counts.passes}`);
+        console.log(`Buses:       ${this.counts.buses}`);
+        console.log(`Clocks:      ${this.counts.clocks}`);
+        console.log(`CCCs:        ${this.counts.cccs}`);
+
+        // Report the largest CCCs, which are the most expensive networks to resolve
+        const pinIds = Object.fromEntries([].concat(...this.pins.map(p => p.nodes.map(n => [n, p.id]))));
+
+        Partition.getLargest(this.cccs, 5).forEach(({ idx, ccc }) => {
+            const names = ccc.nodes.filter(n => pinIds[n] !== undefined)
+                .map(n => pinIds[n])
+                .filter((v, i, a) => a.indexOf(v) === i);
+
+            console.log(`  #${String(idx).padEnd(9)} ${ccc.nodes.length} nodes, ${ccc.transistors.length} transistors` +
+                (names.length ? ` (${names.slice(0, 4).join(', ')}${names.length > 4 ? ', ...' : ''})` : ''));
+        });
+
+        if (this.locality) {
+            const { before, after } = this.locality;
+
+            console.log(`Node span:   ${before.span.toFixed(1)} -> ${after.span.toFixed(1)} (mean)`);
+            console.log(`             ${before.bandwidth} -> ${after.bandwidth} (max)`);
+        }
     }
 
     buildSpec() {
@@ -409,7 +671,7 @@ export class Layout {
             args: this.spec.args,
             memory: this.spec.memory,
             nodes: Object.fromEntries(Object.entries(this.spec.nodeNames).map(([name, set]) => {
-                return [name, set.map(n => this.nodes[n])];
+                return [name, set.map(n => this.nodes[this.constants ? this.constants.getNode(n) : n])];
             })),
             on: this.spec.on,
             off: this.spec.off,
@@ -423,6 +685,12 @@ export class Layout {
             buffers: this.components.getComponents('buffer').map(b => b.getSpec()),
             functions: this.components.getComponents('function').map(f => f.getSpec()),
             cells: this.components.getComponents('cell').map(c => c.getSpec()),
+            plas: this.components.getComponents('pla').map(p => p.getSpec()),
+            words: this.components.getComponents('word').map(w => w.getSpec()),
+            chains: this.components.getComponents('chain').map(ch => ch.getSpec()),
+            passes: this.components.getComponents('pass').map(p => p.getSpec()),
+            buses: this.components.getComponents('bus').map(b => b.getSpec()),
+            clocks: this.components.getComponents('clock').map(c => c.getSpec()),
         };
     }
 }
@@ -0,0 +1,130 @@
+import { Components } from '../components.mjs';
+
+export class Buffers {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.counts = {
+            rewired: 0,
+            removed: 0,
+            longest: 0,
+        };
+    }
+
+    // Collapse chains of buffers. A buffer or function that reads a buffer output is rewired to read the
+    // start of the chain instead, with the combined polarity, so a change reaches it in one resolve
+    // iteration instead of one per link. Buffers left without readers are removed, while outputs that are
+    // pins or still have other readers are kept.
+    collapse() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes())));
+
+        const drivers = countNodes(components, c => c.getOutputNodes());
+
+        // Nodes driven by nothing but a buffer always hold its output
+        const byOutput = new Map(components.getComponents('buffer')
+            .filter(b => drivers.get(b.output) === 1 && !pins.has(b.output))
+            .map(b => [b.output, b]));
+
+        // Find the start of the chain behind a node, along with the polarity and links in between
+        const sources = new Map();
+
+        const getSource = (n, visiting) => {
+            if (sources.has(n)) {
+                return sources.get(n);
+            }
+
+            const b = byOutput.get(n);
+
+            // Loops of buffers are cut where they are found
+            if (!b || visiting.has(n)) {
+                return { node: n, inverting: false, depth: 0 };
+            }
+
+            visiting.add(n);
+
+            const input = getSource(b.input, visiting),
+                  source = { node: input.node, inverting: input.inverting !== b.inverting, depth: input.depth + 1 };
+
+            visiting.delete(n);
+            sources.set(n, source);
+
+            return source;
+        };
+
+        const bypassed = new Set();
+
+        // Buffers take on the polarity of the chain they read
+        components.getComponents('buffer').forEach(b => {
+            const source = getSource(b.input, new Set());
+
+            if (source.depth === 0 || source.node === b.output) {
+                return;
+            }
+
+            components.reduceComponents('buffer', [b.idx]);
+            components.addComponents('buffer', [[b.logic, b.inverting !== source.inverting, source.node, b.output]]);
+
+            bypassed.add(b.input);
+
+            this.counts.rewired++;
+            this.counts.longest = Math.max(this.counts.longest, source.depth);
+        });
+
+        // Functions only take inputs as they are, so they can skip non-inverting links
+        components.getComponents('function').forEach(f => {
+            const inputs = f.inputs.map(n => {
+                const source = getSource(n, new Set());
+
+                return source.depth > 0 && !source.inverting && source.node !== f.output ? source : null;
+            });
+
+            if (inputs.every(s => s === null)) {
+                return;
+            }
+
+            components.reduceComponents('function', [f.idx]);
+            components.addComponents('function', [[f.logic, f.expr, inputs.map((s, i) => s ? s.node : f.inputs[i]), f.output]]);
+
+            f.inputs.filter((n, i) => inputs[i]).forEach(n => bypassed.add(n));
+
+            this.counts.rewired++;
+            this.counts.longest = Math.max(this.counts.longest, ...inputs.filter(Boolean).map(s => s.depth));
+        });
+
+        // Remove buffers that nothing reads any more, which can free the buffers before them in turn
+        for (;;) {
+            const readers = countNodes(components, c => c.getInputNodes()),
+                  unread = components.getComponents('buffer').filter(b => {
+                      return bypassed.has(b.output) && !readers.get(b.output) && !pins.has(b.output);
+                  });
+
+            if (unread.length === 0) {
+                break;
+            }
+
+            components.reduceComponents('buffer', unread.map(b => b.idx));
+
+            unread.forEach(b => bypassed.add(b.input));
+
+            this.counts.removed += unread.length;
+        }
+
+        return this.counts;
+    }
+}
+
+// --- Private ---
+
+function countNodes(components, getNodes) {
+    const counts = new Map();
+
+    Components.getTypes().forEach(type => {
+        components.getComponents(type).forEach(c => {
+            getNodes(c).forEach(n => counts.set(n, (counts.get(n) || 0) + 1));
+        });
+    });
+
+    return counts;
+}
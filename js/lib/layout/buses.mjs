@@ -0,0 +1,75 @@
+import { Components } from '../components.mjs';
+import { Bus } from '../components/bus.mjs';
+
+export class Buses {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.counts = {
+            buses: 0,
+            discharges: 0,
+            widest: 0,
+        };
+    }
+
+    // Replace precharged nodes with bus components. A bus node is pulled up by a single precharge
+    // transistor and pulled down by any of its discharge transistors, and has no other channel, driver,
+    // load or pin. While neither side conducts, it holds its charge. The switch-level resolve reports a
+    // node that is precharged and discharged at once as metastable, which logic reads as 0, so a bus is
+    // pulled down in that case as ratioed NMOS logic is designed to do. Buses that reach register bits
+    // through bidirectional pass transistors, like the main internal buses of the 6502, are left to the
+    // network resolve.
+    build() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes()))),
+              on = this.layout.on.nodes[0],
+              off = this.layout.off.nodes[0],
+              channels = new Map(),
+              drivers = new Set(),
+              loads = new Set(components.getComponents('load').map(l => l.node));
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                if (type === 'transistor') {
+                    if (c.channel[0] !== c.channel[1]) {
+                        c.channel.forEach(n => channels.set(n, [...(channels.get(n) || []), c]));
+                    }
+                } else if (type !== 'load') {
+                    c.getOutputNodes().forEach(n => drivers.add(n));
+                }
+            });
+        });
+
+        const buses = [];
+
+        channels.forEach((list, n) => {
+            if (n === on || n === off || pins.has(n) || loads.has(n) || drivers.has(n)) {
+                return;
+            }
+
+            const getOther = t => t.channel[0] === n ? t.channel[1] : t.channel[0],
+                  precharge = list.filter(t => getOther(t) === on),
+                  discharges = list.filter(t => getOther(t) === off);
+
+            if (precharge.length !== 1 || discharges.length === 0 ||
+                precharge.length + discharges.length !== list.length ||
+                discharges.length > Bus.getMaxDischarges() ||
+                list.some(t => t.type !== list[0].type || t.gate === n)) {
+                return;
+            }
+
+            buses.push({ list, spec: [list[0].type, precharge[0].gate, discharges.map(t => t.gate), n] });
+
+            this.counts.discharges += discharges.length;
+            this.counts.widest = Math.max(this.counts.widest, discharges.length);
+        });
+
+        components.reduceComponents('transistor', [].concat(...buses.map(b => b.list.map(t => t.idx))));
+        components.addComponents('bus', buses.map(b => b.spec));
+
+        this.counts.buses = buses.length;
+
+        return this.counts;
+    }
+}
@@ -0,0 +1,134 @@
+import { Components } from '../components.mjs';
+
+export class Candidates {
+
+    constructor(device, circuit, cache) {
+        this.device = device;
+        this.circuit = circuit;
+        this.cache = cache;
+
+        // Anchor the search on the first circuit component that a search would visit
+        this.type = Components.getTypes().find(type => circuit.components.getCount(type) > 0);
+        this.cx = this.type ? circuit.components.getIndices(this.type)[0] : undefined;
+        this.anchor = this.type ? circuit.components.getComponent(this.type, this.cx) : null;
+
+        // Index compatible device components in search order
+        this.list = this.type ?
+            device.components.getIndices(this.type).filter(dx => this.accepts(dx)) : [];
+
+        this.members = new Set(this.list);
+    }
+
+    // --- Accessors ---
+
+    isEmpty() {
+        return this.type === undefined;
+    }
+
+    getType() {
+        return this.type;
+    }
+
+    getIndex() {
+        return this.cx;
+    }
+
+    getIndices() {
+        return this.list;
+    }
+
+    // --- Updates ---
+
+    update(nodes) {
+        if (this.isEmpty()) {
+            return;
+        }
+
+        const device = this.device,
+              type = this.type,
+              touched = new Set();
+
+        // Find anchor-type components whose neighbourhood changed
+        nodes.forEach(n => {
+            Components.getGroups(type).forEach(group => {
+                device.components.getIndicesByNode(type, group, n).forEach(dx => touched.add(dx));
+            });
+        });
+
+        // Drop reduced components and known mis-matches
+        this.list = this.list.filter(dx => {
+            if (device.components.getComponent(type, dx) && !this.cache.hasMismatch(type, this.cx, dx)) {
+                return true;
+            }
+
+            this.members.delete(dx);
+            return false;
+        });
+
+        // Re-evaluate touched components, keeping search order
+        touched.forEach(dx => {
+            const accepts = this.accepts(dx) && !this.cache.hasMismatch(type, this.cx, dx);
+
+            if (accepts && !this.members.has(dx)) {
+                this.insert(dx);
+            } else if (!accepts && this.members.has(dx)) {
+                this.list.splice(this.list.indexOf(dx), 1);
+                this.members.delete(dx);
+            }
+        });
+    }
+
+    // --- Private ---
+
+    accepts(dx) {
+        const type = this.type,
+              cc = this.anchor,
+              dd = this.device.components.getComponent(type, dx);
+
+        if (!dd || !Components.areCompatible(type, cc, dd)) {
+            return false;
+        }
+
+        // Reject components whose nodes can never satisfy the first node checks
+        return Components.getGroups(type).every(group => {
+            const cnodes = cc.getGroupNodes(group), dnodes = dd.getGroupNodes(group);
+
+            if (cnodes.length !== dnodes.length) {
+                return false;
+            }
+
+            if (cnodes.length === 1) {
+                return this.device.canMatchNodes(this.circuit, cnodes[0], dnodes[0]);
+            } else if (cnodes.length === 2) {
+                return this.device.canMatchNodes(this.circuit, cnodes[0], dnodes[0]) &&
+                    this.device.canMatchNodes(this.circuit, cnodes[1], dnodes[1]) ||
+                    this.device.canMatchNodes(this.circuit, cnodes[0], dnodes[1]) &&
+                    this.device.canMatchNodes(this.circuit, cnodes[1], dnodes[0]);
+            }
+
+            return true;
+        });
+    }
+
+    insert(dx) {
+        const type = this.type,
+              compare = Components.getComparator(type),
+              dd = this.device.components.getComponent(type, dx);
+
+        // Binary search for the position of the component in search order
+        let lo = 0, hi = this.list.length;
+
+        while (lo < hi) {
+            const mid = (lo + hi) >> 1;
+
+            if (compare(this.device.components.getComponent(type, this.list[mid]), dd) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        this.list.splice(lo, 0, dx);
+        this.members.add(dx);
+    }
+}
@@ -0,0 +1,131 @@
+import { Components } from '../components.mjs';
+
+// Fewest stages worth evaluating as one chain
+const MIN_STAGES = 4;
+
+export class Chains {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.counts = {
+            chains: 0,
+            stages: 0,
+            longest: 0,
+        };
+    }
+
+    // Gather ripple paths of gates, such as adder carry chains, into chain components. A chain
+    // evaluates its stages in order within one resolve iteration, instead of one stage per iteration.
+    build() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes()))),
+              drivers = new Map();
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                c.getOutputNodes().forEach(n => drivers.set(n, (drivers.get(n) || 0) + 1));
+            });
+        });
+
+        components.getComponents('load').forEach(l => drivers.set(l.node, (drivers.get(l.node) || 0) + 1));
+
+        // Stage outputs are resolved as soon as they are evaluated, so they must only connect to their stage
+        const isInternal = n => drivers.get(n) === 1 && !pins.has(n) &&
+            components.getIndicesByNode('transistor', 'channel', n).length === 0;
+
+        // Buffers become single-input stages with the same polarity
+        let stages = [
+            ...components.getComponents('function').filter(f => isInternal(f.output)).map(f => ({
+                type: 'function',
+                idx: f.idx,
+                spec: f.getSpec(),
+                inputs: f.inputs,
+                output: f.output,
+            })),
+            ...components.getComponents('buffer').filter(b => isInternal(b.output)).map(b => ({
+                type: 'buffer',
+                idx: b.idx,
+                spec: [b.logic, b.inverting ? 'nor(x1)' : 'nor(nor(x1))', [b.input], b.output],
+                inputs: [b.input],
+                output: b.output,
+            })),
+        ];
+
+        // Repeatedly take the longest remaining path
+        for (;;) {
+            const path = findLongestPath(stages);
+
+            if (path.length < MIN_STAGES) {
+                break;
+            }
+
+            components.addComponents('chain', [[path.map(s => s.spec)]]);
+
+            ['function', 'buffer'].forEach(type => {
+                components.reduceComponents(type, path.filter(s => s.type === type).map(s => s.idx));
+            });
+
+            this.counts.chains++;
+            this.counts.stages += path.length;
+            this.counts.longest = Math.max(this.counts.longest, path.length);
+
+            stages = stages.filter(s => !path.includes(s));
+        }
+
+        return this.counts;
+    }
+}
+
+// --- Private ---
+
+function findLongestPath(stages) {
+    const byOutput = new Map(stages.map(s => [s.output, s])),
+          readers = new Map(stages.map(s => [s, []]));
+
+    stages.forEach(s => {
+        new Set(s.inputs).forEach(n => {
+            if (byOutput.has(n)) {
+                readers.get(byOutput.get(n)).push(s);
+            }
+        });
+    });
+
+    // Longest path starting at each stage, which is well defined because stage outputs have one driver
+    const paths = new Map(),
+          visiting = new Set();
+
+    const getPath = s => {
+        if (paths.has(s)) {
+            return paths.get(s);
+        }
+
+        // Feedback loops are broken where they are found
+        if (visiting.has(s)) {
+            return [];
+        }
+
+        visiting.add(s);
+
+        let best = [s];
+
+        readers.get(s).forEach(r => {
+            const path = getPath(r);
+
+            if (path.length + 1 > best.length && !path.includes(s)) {
+                best = [s, ...path];
+            }
+        });
+
+        visiting.delete(s);
+        paths.set(s, best);
+
+        return best;
+    };
+
+    return stages.reduce((best, s) => {
+        const path = getPath(s);
+
+        return path.length > best.length ? path : best;
+    }, []);
+}
@@ -0,0 +1,185 @@
+import { Components } from '../components.mjs';
+
+const BIT_ZERO = 0;
+const BIT_ONE = 1;
+const BIT_META = -2;
+
+export class Clocks {
+
+    constructor(layout, pin) {
+        this.layout = layout;
+        this.pin = pin;
+
+        this.counts = {
+            nodes: 0,
+            buffers: 0,
+            functions: 0,
+            drivers: 0,
+            steps: 0,
+        };
+    }
+
+    // Gather the clock tree behind a clock pin into a clock component. Tree nodes are outputs of buffers
+    // and functions that only read the clock or other tree nodes, along with push-pull driver outputs
+    // switched by tree nodes, and each must toggle on every clock edge. The changes an edge makes to the
+    // tree are worked out here one resolve iteration at a time, so the component can replay them in the
+    // same order without walking the tree. It replays one step per iteration, so readers see an edge in
+    // the same order as they would from the tree itself.
+    build() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes()))),
+              on = this.layout.on.nodes[0],
+              off = this.layout.off.nodes[0],
+              root = this.pin.nodes[0],
+              drivers = new Map(),
+              loads = new Set(components.getComponents('load').map(l => l.node));
+
+        Components.getTypes().filter(type => type !== 'transistor').forEach(type => {
+            components.getComponents(type).forEach(c => {
+                c.getOutputNodes().forEach(n => drivers.set(n, (drivers.get(n) || 0) + 1));
+            });
+        });
+
+        const getByNode = (type, group, n) => components.getIndicesByNode(type, group, n)
+            .map(idx => components.getComponent(type, idx)).filter(Boolean);
+
+        const getChannels = n => getByNode('transistor', 'channel', n);
+
+        const isLogicOutput = n => drivers.get(n) === 1 && getChannels(n).length === 0;
+
+        // Tree nodes by output, each with a way to evaluate it from the states of its inputs
+        const tree = new Map(),
+              phases = new Map([[root, [BIT_ZERO, BIT_ONE]]]),
+              queue = [root];
+
+        const addNode = (node, entry) => {
+            const phase = [0, 1].map(k => entry.evaluate(n => phases.get(n)[k], null));
+
+            // Tree nodes must settle to opposite known states in the two phases
+            if (phase.some(v => v !== BIT_ZERO && v !== BIT_ONE) || phase[0] === phase[1]) {
+                return false;
+            }
+
+            tree.set(node, entry);
+            phases.set(node, phase);
+            queue.push(node);
+
+            return true;
+        };
+
+        const isCandidate = n => !phases.has(n) && !pins.has(n) && !loads.has(n);
+
+        while (queue.length) {
+            const n = queue.shift();
+
+            getByNode('buffer', 'input', n).forEach(b => {
+                if (isCandidate(b.output) && isLogicOutput(b.output) && addNode(b.output, {
+                    type: 'buffer',
+                    logic: b.logic,
+                    components: [b],
+                    evaluate: get => getInput(get(b.input)) ^ (b.inverting ? 1 : 0),
+                })) {
+                    this.counts.buffers++;
+                }
+            });
+
+            getByNode('function', 'group_1', n).forEach(f => {
+                if (isCandidate(f.output) && isLogicOutput(f.output) && f.inputs.every(i => phases.has(i)) && addNode(f.output, {
+                    type: 'function',
+                    logic: f.logic,
+                    components: [f],
+                    evaluate: get => f.evaluate(f.inputs.map(i => getInput(get(i)))),
+                })) {
+                    this.counts.functions++;
+                }
+            });
+
+            // Push-pull drivers connect their output to one rail or the other in each phase
+            getByNode('transistor', 'gate', n).forEach(t => {
+                const output = t.channel.find(c => c !== on && c !== off);
+
+                if (output === undefined || !isCandidate(output) || drivers.has(output)) {
+                    return;
+                }
+
+                const channels = getChannels(output);
+
+                if (!channels.every(c => phases.has(c.gate) && c.channel.some(r => r === on || r === off))) {
+                    return;
+                }
+
+                if (addNode(output, {
+                    type: 'transistor',
+                    logic: 'cmos',
+                    components: channels,
+                    evaluate: (get, state) => {
+                        const closed = channels.filter(c => get(c.gate) === (c.type === 'nmos' ? BIT_ONE : BIT_ZERO)),
+                              up = closed.some(c => c.channel.includes(on)),
+                              down = closed.some(c => c.channel.includes(off));
+
+                        return up && down ? BIT_META : up ? BIT_ONE : down ? BIT_ZERO : state;
+                    },
+                })) {
+                    this.counts.drivers++;
+                }
+            });
+        }
+
+        if (tree.size === 0) {
+            return this.counts;
+        }
+
+        const nodes = [...tree.keys()];
+
+        // Replay each edge from the settled state of the other phase. Every tree node is evaluated from the
+        // states of the step before, as one resolve iteration would, until nothing changes.
+        const edges = [0, 1].map(k => {
+            const state = new Map([[root, k], ...nodes.map(n => [n, phases.get(n)[k ^ 1]])]),
+                  steps = [];
+
+            for (let i = 0; i <= nodes.length; i++) {
+                const changes = [];
+
+                nodes.forEach((n, idx) => {
+                    const bit = tree.get(n).evaluate(nn => state.get(nn), state.get(n));
+
+                    if (bit !== state.get(n)) {
+                        changes.push([idx, bit]);
+                    }
+                });
+
+                if (changes.length === 0) {
+                    break;
+                }
+
+                changes.forEach(([idx, bit]) => state.set(nodes[idx], bit));
+                steps.push(changes);
+            }
+
+            return nodes.every(n => state.get(n) === phases.get(n)[k]) ? steps : null;
+        });
+
+        if (edges.some(steps => steps === null)) {
+            throw new Error('Clock tree does not settle');
+        }
+
+        tree.forEach(entry => components.reduceComponents(entry.type, entry.components.map(c => c.idx)));
+
+        components.addComponents('clock', [[
+            root,
+            nodes.map(n => [tree.get(n).logic, n, ...phases.get(n)]),
+            edges,
+        ]]);
+
+        this.counts.nodes = nodes.length;
+        this.counts.steps = Math.max(...edges.map(steps => steps.length));
+
+        return this.counts;
+    }
+}
+
+// --- Private ---
+
+function getInput(bit) {
+    return bit === BIT_ONE ? BIT_ONE : BIT_ZERO;
+}
@@ -0,0 +1,168 @@
+import { Components } from '../components.mjs';
+
+export class Constants {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.on = layout.on ? layout.on.nodes[0] : undefined;
+        this.off = layout.off ? layout.off.nodes[0] : undefined;
+
+        // Nodes that are read or written outside of the layout
+        this.pins = new Set([].concat(...layout.pins.map(p => p.getAllNodes())));
+
+        // Nodes merged into another node, and what was removed
+        this.merged = {};
+        this.counts = {
+            off: 0,
+            folded: 0,
+            shorted: 0,
+            dead: 0,
+            loads: 0,
+        };
+    }
+
+    // --- Accessors ---
+
+    getNode(n) {
+        while (this.merged[n] !== undefined) {
+            n = this.merged[n];
+        }
+
+        return n;
+    }
+
+    // --- Propagation ---
+
+    propagate() {
+        const nodes = this.getNodeCount();
+
+        // Repeat until no further components can be removed
+        while (this.propagateOnce()) {
+            // Continue
+        }
+
+        this.counts.nodes = nodes - this.getNodeCount();
+
+        return this.counts;
+    }
+
+    propagateOnce() {
+        const components = this.layout.components,
+              readers = new Map(),
+              drivers = new Map();
+
+        const count = (map, n) => map.set(n, (map.get(n) || 0) + 1),
+              isRail = n => n === this.on || n === this.off;
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                c.getInputNodes().forEach(n => count(readers, n));
+                c.getOutputNodes().forEach(n => count(drivers, n));
+            });
+        });
+
+        const isUndriven = n => !drivers.get(n) && !this.pins.has(n),
+              isUnread = n => !readers.get(n) && !this.pins.has(n);
+
+        const reduced = Object.fromEntries(Components.getTypes().map(type => [type, []])),
+              merges = {},
+              merging = new Set();
+
+        // Transistors with a constant gate are either always off or always conducting
+        components.getComponents('transistor').forEach(t => {
+            const [c1, c2] = t.channel;
+
+            if (c1 === c2) {
+                reduced.transistor.push(t.idx);
+                this.counts.shorted++;
+                return;
+            }
+
+            let gate;
+
+            if (t.gate === this.on) {
+                gate = 1;
+            } else if (t.gate === this.off) {
+                gate = 0;
+            } else if (isUndriven(t.gate)) {
+                gate = null;
+            } else {
+                return;
+            }
+
+            if (!(t.type === 'nmos' && gate === 1 || t.type === 'pmos' && gate === 0)) {
+                reduced.transistor.push(t.idx);
+                this.counts.off++;
+            } else if (!isRail(c1) && !isRail(c2) && !(this.hasLoad(c1) && this.hasLoad(c2)) &&
+                       !merging.has(c1) && !merging.has(c2)) {
+
+                // Merge the channel into one node, unless a rail or two loads would be merged
+                merges[Math.max(c1, c2)] = Math.min(c1, c2);
+                merging.add(c1).add(c2);
+
+                reduced.transistor.push(t.idx);
+                this.counts.folded++;
+            }
+        });
+
+        // Components whose outputs are never read can be removed
+        ['buffer', 'function', 'cell'].forEach(type => {
+            components.getComponents(type).forEach(c => {
+                if (c.getOutputNodes().every(isUnread)) {
+                    reduced[type].push(c.idx);
+                    this.counts.dead++;
+                }
+            });
+        });
+
+        // Loads on nodes with nothing else attached can be removed
+        components.getComponents('load').forEach(l => {
+            if (isUnread(l.node) && drivers.get(l.node) === 1) {
+                reduced.load.push(l.idx);
+                this.counts.loads++;
+            }
+        });
+
+        Components.getTypes().forEach(type => components.reduceComponents(type, reduced[type]));
+
+        if (Object.keys(merges).length > 0) {
+            this.mergeNodes(merges);
+        }
+
+        return Components.getTypes().some(type => reduced[type].length > 0);
+    }
+
+    mergeNodes(merges) {
+        const layout = this.layout;
+
+        Object.entries(merges).forEach(([from, to]) => {
+            this.merged[from] = to;
+        });
+
+        // Map every node in use to the node it was merged into
+        const map = Object.fromEntries([].concat(
+            ...layout.pins.map(p => p.getAllNodes()),
+            ...Components.getTypes().map(type => layout.components.getAllNodes(type)),
+        ).map(n => [n, this.getNode(n)]));
+
+        layout.pins.forEach(p => { p.nodes = p.nodes.map(n => map[n]) });
+
+        Components.getTypes().forEach(type => layout.components.remapNodes(type, map));
+
+        this.pins = new Set([].concat(...layout.pins.map(p => p.getAllNodes())));
+    }
+
+    // --- Private ---
+
+    hasLoad(n) {
+        return this.layout.components.getIndicesByNode('load', 'node', n).length > 0;
+    }
+
+    getNodeCount() {
+        return new Set([].concat(
+            ...this.layout.pins.map(p => p.getAllNodes()),
+            ...Components.getTypes().map(type => this.layout.components.getAllNodes(type)),
+        )).size;
+    }
+}
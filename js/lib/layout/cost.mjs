@@ -0,0 +1,136 @@
+import { Components } from '../components.mjs';
+import { Partition } from './partition.mjs';
+
+// Relative cost of evaluating a component when one of its inputs toggles
+const WEIGHTS = {
+    transistor: 1,
+    buffer: 1,
+    function: 1,
+    cell: 2,
+    pla: 4,
+    word: 2,
+    chain: 2,
+    pass: 1,
+    bus: 1,
+    clock: 1,
+};
+
+// Relative cost of resolving a node as part of a network
+const NODE_WEIGHT = 1;
+
+// Regions to list in the report
+const MAX_REGIONS = 12;
+
+export class Cost {
+
+    // Parse a profile written by a runtime built with -DPROFILE, which lists the evaluation and toggle
+    // counts of each node. Node indices are taken to be netlist nodes, so the profiled layout must have
+    // been compiled without renumbering. A layout compiled without circuits gives the fullest picture.
+    constructor(text) {
+        this.profile = new Map();
+        this.snapshots = [];
+
+        text.split('\n').map(line => line.trim()).filter(line => line && !line.startsWith('#')).forEach(line => {
+            const [node, evals, toggles] = line.split(/\s+/).map(Number);
+
+            if ([node, evals, toggles].some(v => !Number.isInteger(v) || v < 0)) {
+                throw new Error(`Invalid profile line '${line}'`);
+            }
+
+            this.profile.set(node, { evals, toggles });
+        });
+    }
+
+    // Record how the layout reads and connects each node, to be costed once the node map is known
+    snapshot(label, layout) {
+        const fanout = new Map(),
+              channels = new Set(),
+              nodes = new Set([].concat(...layout.pins.map(p => p.getAllNodes())));
+
+        Components.getTypes().forEach(type => {
+            layout.components.getComponents(type).forEach(c => {
+                c.getAllNodes().forEach(n => nodes.add(n));
+
+                // Transistors are only evaluated when their gate toggles, and join networks by their channel
+                const inputs = type === 'transistor' ? [c.gate] : [...new Set(c.getInputNodes())];
+
+                if (type === 'transistor') {
+                    c.channel.forEach(n => channels.add(n));
+                }
+
+                if (WEIGHTS[type]) {
+                    inputs.forEach(n => fanout.set(n, (fanout.get(n) || 0) + WEIGHTS[type]));
+                }
+            });
+        });
+
+        // Regions are the channel-connected components of the unreduced netlist
+        if (this.snapshots.length === 0) {
+            const rails = [layout.on, layout.off].filter(Boolean).map(p => p.nodes[0]);
+
+            this.regions = Partition.buildCCCs(layout.components.getComponents('transistor'), rails)
+                .map(ccc => ({ name: getRegionName(layout.spec, ccc.nodes), nodes: ccc.nodes }));
+        }
+
+        this.snapshots.push({ label, fanout, channels, nodes });
+    }
+
+    // Estimate the cost of each snapshot
+    estimate() {
+        const activity = this.profile;
+
+        // A node costs its readers on every toggle, and a network resolve on every evaluation while it shares
+        // a network with transistor channels. Otherwise it is resolved on its own, once per toggle.
+        const getCost = (snapshot, n) => {
+            const a = activity.get(n);
+
+            if (!a || !snapshot.nodes.has(n)) {
+                return 0;
+            }
+
+            return a.toggles * (snapshot.fanout.get(n) || 0) +
+                (snapshot.channels.has(n) ? a.evals : a.toggles) * NODE_WEIGHT;
+        };
+
+        const getTotal = (snapshot, nodes) => nodes.reduce((sum, n) => sum + getCost(snapshot, n), 0);
+
+        const all = [...activity.keys()];
+
+        const steps = this.snapshots.map((s, idx) => ({
+            label: s.label,
+            cost: getTotal(s, all),
+            saved: idx === 0 ? 0 : getTotal(this.snapshots[idx - 1], all) - getTotal(s, all),
+        }));
+
+        const [first] = this.snapshots,
+              last = this.snapshots[this.snapshots.length - 1];
+
+        const regions = this.regions.map(r => ({
+            name: r.name,
+            nodes: r.nodes.length,
+            before: getTotal(first, r.nodes),
+            after: getTotal(last, r.nodes),
+        })).filter(r => r.before > 0).sort((a, b) => b.before - a.before);
+
+        return {
+            profiled: activity.size,
+            steps: steps,
+            regions: regions.slice(0, MAX_REGIONS),
+        };
+    }
+}
+
+// --- Private ---
+
+// Name a region after a named node in it, preferring the shortest name
+function getRegionName(spec, nodes) {
+    const members = new Set(nodes);
+
+    const names = Object.entries(spec.nodeNames).map(([name, set]) => {
+        const idx = set.findIndex(n => members.has(n));
+
+        return idx < 0 ? null : (set.length === 1 ? name : `${name}[${idx}]`);
+    }).filter(Boolean).sort((a, b) => a.length - b.length || a.localeCompare(b));
+
+    return names.length ? names[0] : `node ${nodes[0]}`;
+}
@@ -0,0 +1,117 @@
+import { Components } from '../components.mjs';
+import { Pla } from '../components/pla.mjs';
+
+// Fewest terms worth evaluating as one PLA
+const MIN_TERMS = 32;
+
+export class Decoder {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.on = layout.on ? layout.on.nodes[0] : undefined;
+        this.off = layout.off ? layout.off.nodes[0] : undefined;
+
+        this.counts = {
+            plas: 0,
+            terms: 0,
+            inputs: 0,
+        };
+    }
+
+    // Gather NOR functions that share a small set of inputs, such as an instruction decode PLA, into
+    // PLA components that evaluate every term from one packed input word
+    build() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes()))),
+              drivers = new Map();
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                c.getOutputNodes().forEach(n => drivers.set(n, (drivers.get(n) || 0) + 1));
+            });
+        });
+
+        components.getComponents('load').forEach(l => drivers.set(l.node, (drivers.get(l.node) || 0) + 1));
+
+        // A PLA only updates a term's output when it changes, so the output must have no other driver
+        const terms = components.getComponents('function').filter(f => {
+            return f.func.op === 'nor' && f.func.args.every(a => a.param) &&
+                drivers.get(f.output) === 1 && !pins.has(f.output);
+        });
+
+        // Terms are evaluated in a single pass, so no PLA input may be a term output
+        const outputs = new Set(terms.map(f => f.output)),
+              eligible = terms.filter(f => f.inputs.every(n => !outputs.has(n) && n !== this.on && n !== this.off));
+
+        const byLogic = {};
+
+        eligible.forEach(f => {
+            (byLogic[f.logic] = byLogic[f.logic] || []).push(f);
+        });
+
+        Object.entries(byLogic).forEach(([logic, remaining]) => {
+            for (;;) {
+                const inputs = selectInputs(remaining, Pla.getMaxInputs()),
+                      covered = remaining.filter(f => f.inputs.every(n => inputs.includes(n)));
+
+                if (covered.length < MIN_TERMS) {
+                    break;
+                }
+
+                const order = inputs.slice().sort((a, b) => a - b);
+
+                components.addComponents('pla', [[
+                    logic,
+                    order,
+                    covered.map(f => [f.output, f.inputs.map(n => order.indexOf(n))]),
+                ]]);
+
+                components.reduceComponents('function', covered.map(f => f.idx));
+
+                this.counts.plas++;
+                this.counts.terms += covered.length;
+                this.counts.inputs += order.length;
+
+                remaining = remaining.filter(f => !covered.includes(f));
+            }
+        });
+
+        return this.counts;
+    }
+}
+
+// --- Private ---
+
+// Greedily pick the inputs that complete the most terms, preferring inputs shared by terms that are
+// closest to completion
+function selectInputs(terms, max) {
+    const selected = new Set();
+
+    while (selected.size < max) {
+        const missing = terms.map(f => [...new Set(f.inputs)].filter(n => !selected.has(n)))
+            .filter(ns => ns.length > 0 && ns.length <= max - selected.size);
+
+        const scores = new Map();
+
+        missing.forEach(ns => {
+            ns.forEach(n => {
+                const [complete, partial] = scores.get(n) || [0, 0];
+
+                scores.set(n, [complete + (ns.length === 1 ? 1 : 0), partial + 1 / ns.length]);
+            });
+        });
+
+        if (scores.size === 0) {
+            break;
+        }
+
+        const [best] = [...scores.entries()].reduce((a, b) => {
+            return (b[1][0] - a[1][0] || b[1][1] - a[1][1] || a[0] - b[0]) > 0 ? b : a;
+        });
+
+        selected.add(best);
+    }
+
+    return [...selected];
+}
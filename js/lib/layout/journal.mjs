@@ -0,0 +1,85 @@
+import crypto from 'crypto';
+
+import { Components } from '../components.mjs';
+import { State } from './state.mjs';
+
+// Bump when a change to the reducer would produce different reductions for the same input
+const VERSION = 1;
+
+export class Journal {
+
+    constructor(spec, data) {
+
+        // Reductions from a previous compile, keyed by the inputs that produced them
+        this.entries = (data && data.version === VERSION && data.entries) ? data.entries : {};
+        this.used = {};
+
+        // Each circuit is keyed on the device netlist and every circuit reduced before it
+        this.key = hash(`${VERSION}`, JSON.stringify(spec, (k, v) => k === 'circuits' ? undefined : v));
+    }
+
+    // --- Accessors ---
+
+    next(circuit) {
+        this.key = hash(this.key, JSON.stringify(circuit.spec));
+
+        return this.key;
+    }
+
+    getReductions(key) {
+        const entry = this.entries[key];
+
+        if (!entry) {
+            return null;
+        }
+
+        this.used[key] = entry;
+
+        return entry.reductions.map(trail => new State(Components.getTypes()).withTrail(unpackTrail(trail)));
+    }
+
+    // --- Updates ---
+
+    setReductions(key, circuit, states) {
+        this.used[key] = {
+            id: circuit.spec.id,
+            reductions: states.map(state => packTrail(state.getTrail())),
+        };
+    }
+
+    buildSpec() {
+
+        // Entries for circuits that no longer exist in this form are dropped
+        return {
+            version: VERSION,
+            entries: this.used,
+        };
+    }
+}
+
+// --- Private ---
+
+function hash(...parts) {
+    const h = crypto.createHash('sha256');
+
+    parts.forEach(p => h.update(p).update('\0'));
+
+    return h.digest('hex');
+}
+
+function packTrail(trail) {
+    const types = Components.getTypes();
+
+    return [].concat(...trail.map(([type, cx, dx]) => [type === null ? -1 : types.indexOf(type), cx, dx]));
+}
+
+function unpackTrail(packed) {
+    const types = Components.getTypes(),
+          trail = [];
+
+    for (let i = 0; i < packed.length; i += 3) {
+        trail.push([packed[i] < 0 ? null : types[packed[i]], packed[i + 1], packed[i + 2]]);
+    }
+
+    return trail;
+}
@@ -0,0 +1,220 @@
+import { Components } from '../components.mjs';
+import { State } from './state.mjs';
+
+export class Matcher {
+
+    constructor(device, circuit, cache, trace) {
+        this.device = device;
+        this.circuit = circuit;
+        this.cache = cache;
+
+        // Records what the search inspected, when given
+        this.trace = trace ? trace : null;
+    }
+
+    // --- Searches ---
+
+    matchCircuit(type, cx, anchors) {
+        let state = new State(Components.getTypes());
+
+        // Seed the search from the anchor candidates
+        if (type !== undefined) {
+            state = this.findComponent(type, cx, anchors, state);
+
+            if (!state) {
+                return false;
+            }
+        }
+
+        return this.matchRemaining(state);
+    }
+
+    matchAnchor(type, cx, dx) {
+
+        // Evaluate a single anchor candidate exactly as matchCircuit would
+        const state = this.findComponent(type, cx, [dx], new State(Components.getTypes()));
+
+        if (!state) {
+            return { match: false, state: null };
+        }
+
+        // A matched anchor that cannot be completed ends the search for this circuit
+        return { match: true, state: this.matchRemaining(state) };
+    }
+
+    matchRemaining(state) {
+
+        // Match all components not reached through the nodes of the anchor
+        for (const type of Components.getTypes()) {
+            for (const cx of this.circuit.components.getIndices(type)) {
+                if (state.getDeviceComponent(type, cx) !== undefined) {
+                    continue;
+                }
+
+                if (this.trace) {
+                    this.trace.global = true;
+                }
+
+                state = this.findComponent(type, cx, this.device.components.getIndices(type), state);
+
+                if (!state) {
+                    return false;
+                }
+            }
+        }
+
+        return state;
+    }
+
+    // --- Component matchers ---
+
+    matchNodes(cnx, dnx, state) {
+        const circuit = this.circuit,
+              device = this.device;
+
+        // Check if nodes are already matched or already in use
+        if (state.doNodesMatch(cnx, dnx)) {
+            return state;
+        }
+
+        if (state.doNodesConflict(cnx, dnx)) {
+            return false;
+        }
+
+        // Check pins and component counts
+        const ok = device.canMatchNodes(circuit, cnx, dnx);
+
+        if (this.trace) {
+            this.trace.read(dnx, cnx, ok);
+        }
+
+        if (!ok) {
+            return false;
+        }
+
+        // Update state
+        state = state.withNode(cnx, dnx);
+
+        // Match components
+        for (const type of Components.getTypes()) {
+            for (const group of Components.getGroups(type)) {
+                const cxs = circuit.components.getIndicesByNode(type, group, cnx),
+                      dxs = device.components.getIndicesByNode(type, group, dnx);
+
+                for (const cx of cxs) {
+                    state = this.findComponent(type, cx, dxs, state);
+
+                    if (!state) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return state;
+    }
+
+    matchComponents(type, cx, dx, state) {
+
+        // Check if components are either matched or otherwise in use
+        if (state.doComponentsMatch(type, cx, dx)) {
+            return state;
+        }
+
+        if (state.doComponentsConflict(type, cx, dx)) {
+            return false;
+        }
+
+        // Check component compatibility
+        let cc = this.circuit.components.getComponent(type, cx),
+            dd = this.device.components.getComponent(type, dx);
+
+        if (!Components.areCompatible(type, cc, dd)) {
+            return false;
+        }
+
+        // Match nodes
+        state = state.withComponent(type, cx, dx);
+
+        for (const group of Components.getGroups(type)) {
+            const cnodes = cc.getGroupNodes(group), dnodes = dd.getGroupNodes(group);
+
+            if (cnodes.length !== dnodes.length) {
+                return false;
+            }
+
+            if (cnodes.length === 0) {
+                continue;
+            } else if (cnodes.length === 1) {
+                state = this.matchNodes(cnodes[0], dnodes[0], state)
+
+                if (!state) {
+                    return false;
+                }
+            } else if (cnodes.length === 2) {
+                const mark = state.mark();
+
+                let groupState = false;
+
+                if ((groupState = this.matchNodes(cnodes[0], dnodes[0], state)) &&
+                    (groupState = this.matchNodes(cnodes[1], dnodes[1], groupState))) {
+
+                    state = groupState;
+                } else if (state.undo(mark),
+                           (groupState = this.matchNodes(cnodes[0], dnodes[1], state)) &&
+                           (groupState = this.matchNodes(cnodes[1], dnodes[0], groupState))) {
+                    state = groupState;
+                } else {
+                    return false;
+                }
+            } else {
+                throw new Error('Component groups with greater than 2 nodes not supported');
+            }
+        }
+
+        return state;
+    }
+
+    // --- Component finders ---
+
+    findComponent(type, cx, dxs, state) {
+        const cache = this.cache;
+
+        // Components that are already matched can only match themselves
+        const mx = state.getDeviceComponent(type, cx);
+
+        if (mx !== undefined) {
+            return (dxs.includes(mx) && !cache.hasMismatch(type, cx, mx)) ? state : false;
+        }
+
+        // Each attempt starts from the same state
+        const mark = state.mark();
+
+        for (const dx of dxs) {
+
+            // Short-circuit if this is a known mis-match
+            if (cache.hasMismatch(type, cx, dx, state)) {
+                continue;
+            }
+
+            const frame = this.trace ? this.trace.enter(type, dx) : -1;
+
+            let newState = this.matchComponents(type, cx, dx, state);
+
+            if (this.trace) {
+                this.trace.leave(frame, newState);
+            }
+
+            if (newState) {
+                return newState;
+            }
+
+            state.undo(mark);
+
+            // Cache this mis-match for future searches
+            cache.cacheMismatch(type, cx, dx, state);
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,346 @@
+import { Components } from '../components.mjs';
+import { Function } from '../components/function.mjs';
+
+// Largest subgraph worth mining, in transistors
+const MAX_TRANSISTORS = 12;
+
+// Most nodes a subgraph may share with the rest of the device
+const MAX_BOUNDARY = 8;
+
+// Fewest instances worth proposing as a circuit
+const MIN_INSTANCES = 2;
+
+// Rounds of label refinement used to tell subgraphs apart
+const ROUNDS = 4;
+
+export class Miner {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.vcc = layout.on ? layout.on.nodes[0] : undefined;
+        this.vss = layout.off ? layout.off.nodes[0] : undefined;
+        this.rails = [this.vcc, this.vss].filter(n => n !== undefined);
+        this.pins = new Set([].concat(...layout.pins.filter(p => p.type !== 'src').map(p => p.nodes)));
+        this.loads = new Map(layout.components.getComponents('load').map(l => [l.node, l.type]));
+
+        // Transistors touching each node through their gate or channel
+        this.transistors = layout.components.getComponents('transistor');
+        this.byNode = new Map();
+
+        this.transistors.forEach(t => {
+            new Set([t.gate, ...t.channel]).forEach(n => {
+                if (!this.byNode.has(n)) {
+                    this.byNode.set(n, []);
+                }
+
+                this.byNode.get(n).push(t);
+            });
+        });
+    }
+
+    // Group repeated transistor subgraphs by shape, ranked by the transistors and loads that reducing
+    // every instance to a single component would save
+    mine() {
+        const classes = new Map();
+
+        this.getUnits().forEach(unit => {
+            const subgraph = this.describe(unit);
+
+            if (!subgraph) {
+                return;
+            }
+
+            if (!classes.has(subgraph.key)) {
+                classes.set(subgraph.key, []);
+            }
+
+            classes.get(subgraph.key).push(subgraph);
+        });
+
+        return [...classes.values()].map(subgraphs => {
+
+            // Pairs of stages can overlap, so only count instances that share no transistors
+            const used = new Set(),
+                  instances = subgraphs.filter(s => {
+                      if (s.transistors.some(t => used.has(t))) {
+                          return false;
+                      }
+
+                      s.transistors.forEach(t => used.add(t));
+
+                      return true;
+                  });
+
+            const [first] = instances,
+                  saved = first.transistors.length + first.loads.length - 1;
+
+            return {
+                instances: instances.length,
+                transistors: first.transistors.length,
+                loads: first.loads.length,
+                inputs: first.inputs.length,
+                outputs: first.outputs.length,
+                saved: saved,
+                score: instances.length * saved,
+                example: first,
+            };
+        }).filter(c => c.instances >= MIN_INSTANCES && c.saved > 0)
+          .sort((a, b) => b.score - a.score || b.instances - a.instances || a.transistors - b.transistors)
+          .map((c, idx) => Object.assign(c, { circuit: this.buildCircuit(c, idx) }));
+    }
+
+    // --- Private ---
+
+    // Mining starts from channel-connected components, alone and paired with a stage they drive
+    getUnits() {
+        const cccs = this.layout.cccs.map(ccc => ccc.transistors.map(tx => this.transistors[tx]))
+            .filter(ts => ts.length <= MAX_TRANSISTORS);
+
+        const byGate = new Map();
+
+        cccs.forEach((ts, idx) => {
+            ts.forEach(t => {
+                if (!byGate.has(t.gate)) {
+                    byGate.set(t.gate, new Set());
+                }
+
+                byGate.get(t.gate).add(idx);
+            });
+        });
+
+        const units = cccs.slice();
+
+        cccs.forEach((ts, idx) => {
+            const nodes = new Set([].concat(...ts.map(t => t.channel)).filter(n => !this.rails.includes(n)));
+
+            nodes.forEach(n => {
+                (byGate.get(n) || []).forEach(other => {
+                    if (other !== idx && ts.length + cccs[other].length <= MAX_TRANSISTORS) {
+                        units.push([...ts, ...cccs[other]]);
+                    }
+                });
+            });
+        });
+
+        return units;
+    }
+
+    // Build the boundary and a shape key for a set of transistors
+    describe(transistors) {
+        const members = new Set(transistors),
+              channels = new Set([].concat(...transistors.map(t => t.channel)).filter(n => !this.rails.includes(n))),
+              gates = new Set(transistors.map(t => t.gate).filter(n => !this.rails.includes(n)));
+
+        const inputs = [...gates].filter(n => !channels.has(n)),
+              outputs = [...channels].filter(n => this.isExternal(n, members));
+
+        if (outputs.length === 0 || inputs.length + outputs.length > MAX_BOUNDARY) {
+            return null;
+        }
+
+        // Label nodes by their role and transistors by their type, then refine each label with its neighbours
+        const nodeRole = n => {
+            if (n === this.vcc) {
+                return 'vcc';
+            }
+
+            if (n === this.vss) {
+                return 'vss';
+            }
+
+            // Loads on inputs belong to the stage that drives them
+            if (inputs.includes(n)) {
+                return 'in';
+            }
+
+            return [outputs.includes(n) ? 'out' : 'int', this.loads.get(n) || ''].join(':');
+        };
+
+        const nodes = [...new Set([].concat(...transistors.map(t => [t.gate, ...t.channel])))];
+
+        let labels = new Map([
+            ...nodes.map(n => [n, nodeRole(n)]),
+            ...transistors.map(t => [t, t.type]),
+        ]);
+
+        for (let round = 0; round < ROUNDS; round++) {
+            const next = new Map();
+
+            nodes.forEach(n => {
+                const around = transistors.filter(t => t.gate === n || t.channel.includes(n))
+                    .map(t => (t.gate === n ? 'g' : 'c') + labels.get(t)).sort();
+
+                next.set(n, hash(labels.get(n) + '|' + around.join(',')));
+            });
+
+            transistors.forEach(t => {
+                const channel = t.channel.map(n => labels.get(n)).sort();
+
+                next.set(t, hash(labels.get(t) + '|' + labels.get(t.gate) + '|' + channel.join(',')));
+            });
+
+            labels = next;
+        }
+
+        const key = [...nodes.map(n => labels.get(n)), ...transistors.map(t => labels.get(t))].sort().join(' ');
+
+        return {
+            key: key,
+            transistors: transistors,
+            nodes: nodes,
+            inputs: inputs.sort((a, b) => labels.get(a).localeCompare(labels.get(b)) || a - b),
+            outputs: outputs.sort((a, b) => labels.get(a).localeCompare(labels.get(b)) || a - b),
+            loads: nodes.filter(n => this.loads.has(n) && !this.rails.includes(n) && !inputs.includes(n)),
+        };
+    }
+
+    isExternal(n, members) {
+        if (this.pins.has(n)) {
+            return true;
+        }
+
+        if ((this.byNode.get(n) || []).some(t => !members.has(t))) {
+            return true;
+        }
+
+        return Components.getTypes().filter(type => type !== 'transistor' && type !== 'load')
+            .some(type => this.layout.hasComponentsAt(type, n));
+    }
+
+    // Write out a circuit entry for the first instance, if the subgraph is a static gate that an existing
+    // component can express
+    buildCircuit(c, idx) {
+        const s = c.example,
+              names = new Map();
+
+        this.rails.filter(n => s.nodes.includes(n)).forEach(n => names.set(n, n === this.vcc ? 'vcc' : 'vss'));
+
+        s.inputs.forEach((n, i) => names.set(n, `x${i + 1}`));
+        s.outputs.forEach((n, i) => names.set(n, s.outputs.length === 1 ? 'out' : `out${i + 1}`));
+        s.nodes.filter(n => !names.has(n)).forEach((n, i) => names.set(n, `n${i + 1}`));
+
+        const index = new Map([...names.keys()].map((n, i) => [n, i])),
+              replacement = this.getReplacement(s, names);
+
+        if (!replacement) {
+            return null;
+        }
+
+        return {
+            id: `mined${idx + 1}`,
+            name: `Mined Subgraph ${idx + 1} (${c.instances} instances)`,
+            type: replacement.type,
+            enabled: false,
+            args: replacement.args,
+            nodes: Object.fromEntries([...names.entries()].map(([n, name]) => [name, index.get(n)])),
+            ...(s.nodes.includes(this.vcc) ? { on: 'vcc' } : {}),
+            ...(s.nodes.includes(this.vss) ? { off: 'vss' } : {}),
+            inputs: s.inputs.map(n => names.get(n)),
+            outputs: s.outputs.map(n => names.get(n)),
+            loads: s.loads.map(n => [this.loads.get(n), index.get(n)]),
+            transistors: s.transistors.map(t => [t.type, index.get(t.gate), ...t.channel.map(n => index.get(n))]),
+        };
+    }
+
+    // A single output with a pull-up load over an NMOS series-parallel network to ground is a function
+    getReplacement(s, names) {
+        const [out] = s.outputs;
+
+        if (s.outputs.length !== 1 || this.loads.get(out) !== 'on' || s.loads.length !== 1 ||
+            s.transistors.some(t => t.type !== 'nmos' || !s.inputs.includes(t.gate) || t.channel.includes(this.vcc))) {
+            return null;
+        }
+
+        const edges = s.transistors.map(t => ({ a: t.channel[0], b: t.channel[1], expr: { param: t.gate } })),
+              expr = reduceSeriesParallel(edges, out, this.vss);
+
+        if (!expr) {
+            return null;
+        }
+
+        // Functions evaluate a single NAND or NOR of their inputs
+        const params = expr.param !== undefined ? [expr.param] : expr.args.map(e => e.param);
+
+        if (params.some(p => p === undefined) || new Set(params).size !== params.length) {
+            return null;
+        }
+
+        const text = `${expr.op === 'and' ? 'nand' : 'nor'}(${params.map((p, i) => `x${i + 1}`).join(',')})`;
+
+        try {
+            new Function(-1, 'nmos', text, params, out);
+        } catch (e) {
+            return null;
+        }
+
+        return {
+            type: 'function',
+            args: ['nmos', text, params.map(n => `$${names.get(n)}`), `$${names.get(out)}`],
+        };
+    }
+}
+
+// --- Private ---
+
+// Collapse parallel edges and series chains through internal nodes until one edge joins the two ends
+function reduceSeriesParallel(edges, from, to) {
+    for (;;) {
+        if (edges.length === 1) {
+            const [e] = edges;
+
+            return (e.a === from && e.b === to || e.a === to && e.b === from) ? e.expr : null;
+        }
+
+        let changed = false;
+
+        // Parallel edges between the same pair of nodes conduct if either does
+        for (let i = 0; i < edges.length && !changed; i++) {
+            for (let j = i + 1; j < edges.length && !changed; j++) {
+                const [x, y] = [edges[i], edges[j]];
+
+                if (x.a === y.a && x.b === y.b || x.a === y.b && x.b === y.a) {
+                    edges.splice(j, 1);
+                    edges[i] = { a: x.a, b: x.b, expr: join('or', x.expr, y.expr) };
+                    changed = true;
+                }
+            }
+        }
+
+        // Internal nodes on exactly two edges join them in series
+        if (!changed) {
+            const degree = new Map();
+
+            edges.forEach(e => [e.a, e.b].forEach(n => degree.set(n, (degree.get(n) || 0) + 1)));
+
+            const node = [...degree.keys()].find(n => n !== from && n !== to && degree.get(n) === 2);
+
+            if (node !== undefined) {
+                const [x, y] = edges.filter(e => e.a === node || e.b === node),
+                      ends = [x.a === node ? x.b : x.a, y.a === node ? y.b : y.a];
+
+                edges = edges.filter(e => e !== x && e !== y);
+                edges.push({ a: ends[0], b: ends[1], expr: join('and', x.expr, y.expr) });
+                changed = true;
+            }
+        }
+
+        if (!changed) {
+            return null;
+        }
+    }
+}
+
+function join(op, x, y) {
+    return { op, args: [].concat(...[x, y].map(e => e.op === op ? e.args : [e])) };
+}
+
+function hash(text) {
+    let h = 0x811C9DC5;
+
+    for (let i = 0; i < text.length; i++) {
+        h = Math.imul(h ^ text.charCodeAt(i), 0x01000193);
+    }
+
+    return (h >>> 0).toString(36);
+}
@@ -0,0 +1,65 @@
+export class Order {
+
+    static getModes() {
+        return ['none', 'bfs', 'rcm'];
+    }
+
+    // Number nodes so that nodes sharing a component are close together, using a Cuthill-McKee
+    // breadth-first ordering, optionally reversed. Fixed nodes, such as power rails, are numbered first.
+    static orderNodes(nodes, edges, fixed, reverse) {
+        const adjacent = new Map(nodes.map(n => [n, new Set()]));
+
+        edges.forEach(([a, b]) => {
+            if (!fixed.includes(a) && !fixed.includes(b)) {
+                adjacent.get(a).add(b);
+                adjacent.get(b).add(a);
+            }
+        });
+
+        const degree = n => adjacent.get(n).size,
+              byDegree = (a, b) => degree(a) - degree(b) || a - b;
+
+        // Start each connected region from its least connected node
+        const starts = nodes.filter(n => !fixed.includes(n)).sort(byDegree),
+              visited = new Set(fixed),
+              order = [];
+
+        starts.forEach(start => {
+            if (visited.has(start)) {
+                return;
+            }
+
+            visited.add(start);
+
+            for (let i = order.push(start) - 1; i < order.length; i++) {
+                [...adjacent.get(order[i])].filter(n => !visited.has(n)).sort(byDegree).forEach(n => {
+                    visited.add(n);
+                    order.push(n);
+                });
+            }
+        });
+
+        if (reverse) {
+            order.reverse();
+        }
+
+        return [...fixed.filter(n => nodes.includes(n)), ...order];
+    }
+
+    // Measure how far apart connected nodes are numbered
+    static measure(edges, map) {
+        let bandwidth = 0, span = 0;
+
+        edges.forEach(([a, b]) => {
+            const d = Math.abs(map[a] - map[b]);
+
+            bandwidth = Math.max(bandwidth, d);
+            span += d;
+        });
+
+        return {
+            bandwidth,
+            span: edges.length ? span / edges.length : 0,
+        };
+    }
+}
@@ -0,0 +1,68 @@
+export class Partition {
+
+    // Split transistors into channel-connected components (CCCs), the sets of nodes joined through
+    // transistor channels without passing through a power rail. A CCC bounds every network the
+    // emulator can resolve from one of its nodes.
+    static buildCCCs(transistors, rails) {
+        const parents = new Map();
+
+        const find = n => {
+            while (parents.get(n) !== n) {
+                parents.set(n, parents.get(parents.get(n)));
+                n = parents.get(n);
+            }
+
+            return n;
+        };
+
+        const add = n => {
+            if (!parents.has(n)) {
+                parents.set(n, n);
+            }
+        };
+
+        // Transistors shorted to themselves or between rails are never part of a network
+        const members = transistors.map((t, tx) => ({
+            tx,
+            nodes: t.channel[0] === t.channel[1] ? [] : t.channel.filter(n => !rails.includes(n)),
+        })).filter(({ nodes }) => nodes.length > 0);
+
+        members.forEach(({ nodes }) => {
+            nodes.forEach(add);
+
+            if (nodes.length === 2) {
+                const [a, b] = nodes.map(find);
+
+                // Keep the lowest node as the root so components are numbered in node order
+                if (a !== b) {
+                    parents.set(Math.max(a, b), Math.min(a, b));
+                }
+            }
+        });
+
+        const byRoot = new Map();
+
+        [...parents.keys()].sort((a, b) => a - b).forEach(n => {
+            const root = find(n);
+
+            if (!byRoot.has(root)) {
+                byRoot.set(root, { nodes: [], transistors: [] });
+            }
+
+            byRoot.get(root).nodes.push(n);
+        });
+
+        members.forEach(({ tx, nodes }) => byRoot.get(find(nodes[0])).transistors.push(tx));
+
+        return [...byRoot.keys()].sort((a, b) => a - b).map(root => byRoot.get(root));
+    }
+
+    // Find the largest CCCs, which bound the cost of resolving a network
+    static getLargest(cccs, count) {
+        return cccs.map((ccc, idx) => ({ idx, ccc }))
+            .sort((a, b) => b.ccc.nodes.length - a.ccc.nodes.length ||
+                            b.ccc.transistors.length - a.ccc.transistors.length ||
+                            a.idx - b.idx)
+            .slice(0, count);
+    }
+}
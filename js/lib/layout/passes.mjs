@@ -0,0 +1,84 @@
+import { Components } from '../components.mjs';
+
+export class Passes {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.counts = {
+            passes: 0,
+            loads: 0,
+            driven: 0,
+            rails: 0,
+        };
+    }
+
+    // Replace pass transistors whose direction is known with pass components. The output side must be a
+    // storage node reached through no other channel, so it only ever holds charge or follows the input.
+    // The input side must always be driven at least as strongly as a load, so the output charge can never
+    // flow back into it. That holds for a rail, a node with a load, or the output of a buffer or function.
+    // Transistors that can conduct both ways are left for the network resolve.
+    build() {
+        const components = this.layout.components,
+              pins = new Set([].concat(...this.layout.pins.map(p => p.getAllNodes()))),
+              rails = [this.layout.on, this.layout.off].filter(Boolean).map(p => p.nodes[0]),
+              channels = new Map(),
+              drivers = new Map(),
+              loads = new Set(components.getComponents('load').map(l => l.node));
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                const counts = type === 'transistor' ? channels : drivers;
+
+                c.getOutputNodes().forEach(n => counts.set(n, (counts.get(n) || 0) + 1));
+            });
+        });
+
+        // Buffers and functions always drive their output to a known level
+        const driven = new Set([
+            ...components.getComponents('buffer').map(b => b.output),
+            ...components.getComponents('function').map(f => f.output),
+        ]);
+
+        const isOutput = n => !rails.includes(n) && !pins.has(n) && !loads.has(n) &&
+            channels.get(n) === 1 && !drivers.get(n);
+
+        const getInputKind = n => {
+            if (rails.includes(n)) {
+                return 'rails';
+            }
+
+            if (loads.has(n)) {
+                return 'loads';
+            }
+
+            return driven.has(n) ? 'driven' : null;
+        };
+
+        const passes = [];
+
+        components.getComponents('transistor').forEach(t => {
+            const [a, b] = t.channel;
+
+            if (a === b) {
+                return;
+            }
+
+            [[a, b], [b, a]].forEach(([input, output]) => {
+                const kind = getInputKind(input);
+
+                if (kind && isOutput(output) && output !== t.gate) {
+                    passes.push({ t, spec: [t.type, t.gate, input, output] });
+                    this.counts[kind]++;
+                }
+            });
+        });
+
+        components.reduceComponents('transistor', passes.map(p => p.t.idx));
+        components.addComponents('pass', passes.map(p => p.spec));
+
+        this.counts.passes = passes.length;
+
+        return this.counts;
+    }
+}
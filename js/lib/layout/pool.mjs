@@ -0,0 +1,194 @@
+import { Worker, MessageChannel, receiveMessageOnPort } from 'worker_threads';
+
+import { Trace } from './trace.mjs';
+
+// Number of anchor candidates sent to a worker at once
+const BATCH_SIZE = 4;
+
+// Number of batches each worker may have in flight
+const MAX_BATCHES = 2;
+
+// Milliseconds to block before polling the workers again
+const WAIT_TIMEOUT = 100;
+
+export class Pool {
+
+    constructor(device, spec, jobs) {
+        this.device = device;
+
+        // Workers signal new messages through a shared counter
+        this.signal = new Int32Array(new SharedArrayBuffer(4));
+
+        this.workers = [...Array(jobs).keys()].map(() => {
+            const channel = new MessageChannel();
+
+            const worker = new Worker(new URL('./worker.mjs', import.meta.url), {
+                workerData: { spec, signal: this.signal, port: channel.port2 },
+                transferList: [channel.port2],
+            });
+
+            worker.unref();
+
+            return { worker, port: channel.port1, batches: 0 };
+        });
+
+        // Number of edits made to the device, and the last edit that changed each node
+        this.epoch = 0;
+        this.changedAt = new Map();
+
+        // Last edit that added components of each type to each node
+        this.addedAt = {};
+
+        this.circuit = -1;
+        this.results = new Map();
+        this.pending = new Set();
+    }
+
+    // --- Circuits ---
+
+    begin(circuit, layout, type, cx) {
+        this.circuit = circuit;
+        this.layout = layout;
+        this.type = type;
+        this.cx = cx;
+
+        // Results for other circuits are discarded as they arrive
+        this.results.clear();
+        this.pending.clear();
+    }
+
+    publish(trail, removed, type, added) {
+        this.epoch++;
+
+        if (!this.addedAt[type]) {
+            this.addedAt[type] = new Map();
+        }
+
+        removed.forEach(n => this.changedAt.set(n, this.epoch));
+        added.forEach(n => this.changedAt.set(n, this.epoch));
+        added.forEach(n => this.addedAt[type].set(n, this.epoch));
+
+        // Mirror the edit in each worker before any further evaluations
+        this.workers.forEach(w => w.port.postMessage({ op: 'apply', circuit: this.circuit, trail }));
+    }
+
+    // --- Evaluation ---
+
+    lookup(dxs, i) {
+        const dx = dxs[i];
+
+        this.dispatch(dxs, i);
+
+        for (;;) {
+            const result = this.results.get(dx);
+
+            if (result && this.isValid(result)) {
+                return result;
+            }
+
+            // Candidates that are not in flight are evaluated by the caller
+            if (!this.pending.has(dx)) {
+                this.results.delete(dx);
+                return null;
+            }
+
+            this.receive();
+        }
+    }
+
+    dispatch(dxs, i) {
+        const limit = Math.min(dxs.length, i + this.workers.length * BATCH_SIZE * MAX_BATCHES);
+
+        let j = i;
+
+        for (const w of this.workers) {
+            while (w.batches < MAX_BATCHES) {
+                const batch = [];
+
+                // Collect candidates in search order that have no usable result yet
+                for (; j < limit && batch.length < BATCH_SIZE; j++) {
+                    const dx = dxs[j], result = this.results.get(dx);
+
+                    if (this.pending.has(dx) || result && this.isValid(result)) {
+                        continue;
+                    }
+
+                    this.results.delete(dx);
+                    this.pending.add(dx);
+                    batch.push(dx);
+                }
+
+                if (batch.length === 0) {
+                    return;
+                }
+
+                w.port.postMessage({ op: 'evaluate', circuit: this.circuit, type: this.type, cx: this.cx, dxs: batch });
+                w.batches++;
+            }
+        }
+    }
+
+    receive() {
+        const seen = Atomics.load(this.signal, 0);
+
+        if (!this.drain()) {
+            Atomics.wait(this.signal, 0, seen, WAIT_TIMEOUT);
+            this.drain();
+        }
+    }
+
+    drain() {
+        let received = false;
+
+        this.workers.forEach(w => {
+            let msg;
+
+            while ((msg = receiveMessageOnPort(w.port))) {
+                const { error, circuit, results } = msg.message;
+
+                if (error) {
+                    throw new Error(`Worker failed: ${error}`);
+                }
+
+                w.batches--;
+                received = true;
+
+                if (circuit !== this.circuit) {
+                    continue;
+                }
+
+                results.forEach(result => {
+                    this.pending.delete(result.dx);
+                    this.results.set(result.dx, result);
+                });
+            }
+        });
+
+        return received;
+    }
+
+    isValid(result) {
+
+        // Searches over the whole device are only valid if nothing changed since
+        if (result.global) {
+            return result.epoch === this.epoch;
+        }
+
+        // Otherwise the search must be unaffected by the edits around the nodes it inspected
+        return Trace.isValid(this.device, this.layout, result.frames, result.reads, {
+            changed: n => this.changedAt.get(n) > result.epoch,
+            added: (n, cnx) => Object.entries(this.addedAt).some(([type, map]) => {
+                return map.get(n) > result.epoch && this.layout.hasComponentsAt(type, cnx);
+            }),
+        });
+    }
+
+    close() {
+        this.workers.forEach(w => {
+            w.port.close();
+            w.worker.terminate();
+        });
+
+        this.workers = [];
+    }
+}
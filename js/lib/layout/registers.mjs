@@ -0,0 +1,93 @@
+import { Components } from '../components.mjs';
+import { Word } from '../components/word.mjs';
+
+// Fewest bits worth latching as one word
+const MIN_BITS = 4;
+
+export class Registers {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        this.counts = {
+            words: 0,
+            bits: 0,
+        };
+    }
+
+    // Gather single-bit latch cells that share their write and read enables into word-wide registers,
+    // which latch every bit at once and only update the outputs that changed
+    build() {
+        const components = this.layout.components,
+              drivers = new Map();
+
+        Components.getTypes().forEach(type => {
+            components.getComponents(type).forEach(c => {
+                c.getOutputNodes().forEach(n => drivers.set(n, (drivers.get(n) || 0) + 1));
+            });
+        });
+
+        components.getComponents('load').forEach(l => drivers.set(l.node, (drivers.get(l.node) || 0) + 1));
+
+        // Outputs may not be written from outside the layout or driven by anything else
+        const writable = new Set([].concat(...this.layout.pins.filter(p => p.writable).map(p => p.nodes)));
+
+        const cells = components.getComponents('cell').filter(c => {
+            return c.inputs.length === 1 && c.outputs.length === 1 &&
+                drivers.get(c.outputs[0]) === 1 && !writable.has(c.outputs[0]);
+        });
+
+        // Group cells by their shared enables
+        const groups = new Map();
+
+        cells.forEach(c => {
+            const key = JSON.stringify([c.logic, c.type, c.writes, c.reads]);
+
+            if (!groups.has(key)) {
+                groups.set(key, []);
+            }
+
+            groups.get(key).push(c);
+        });
+
+        groups.forEach(group => {
+            const ordered = group.slice().sort((a, b) => this.getBitOrder(a.outputs[0], b.outputs[0]));
+
+            for (let i = 0; i + MIN_BITS <= ordered.length; i += Word.getMaxBits()) {
+                const bits = ordered.slice(i, i + Word.getMaxBits()),
+                      [first] = bits;
+
+                components.addComponents('word', [[
+                    first.logic,
+                    first.type,
+                    bits.map(c => c.inputs[0]),
+                    bits.map(c => c.outputs[0]),
+                    first.writes,
+                    first.reads,
+                ]]);
+
+                components.reduceComponents('cell', bits.map(c => c.idx));
+
+                this.counts.words++;
+                this.counts.bits += bits.length;
+            }
+        });
+
+        return this.counts;
+    }
+
+    // --- Private ---
+
+    // Keep the bits of a pin or register in order, so a word reads like the value it holds
+    getBitOrder(a, b) {
+        const pins = this.layout.pins,
+              pa = pins.findIndex(p => p.nodes.includes(a)),
+              pb = pins.findIndex(p => p.nodes.includes(b));
+
+        if (pa >= 0 && pa === pb) {
+            return pins[pa].nodes.indexOf(a) - pins[pb].nodes.indexOf(b);
+        }
+
+        return (pa < 0) - (pb < 0) || pa - pb || a - b;
+    }
+}
@@ -20,58 +20,83 @@ export class State {
             this.circuit.components[type] = {};
             this.device.components[type] = {};
         });
+
+        // Matches in the order they were made, so that a failed branch can be undone
+        this.trail = [];
     }
 
     isEmpty() {
         return this.numNodes === 0 && this.numComponents === 0;
     }
 
-    copyWithNode(cx, dx) {
-        let copy = new State(this.types);
+    mark() {
+        return this.trail.length;
+    }
 
-        // Use existing component maps
-        copy.circuit.components = this.circuit.components;
-        copy.device.components = this.device.components;
-        copy.numComponents = this.numComponents;
+    undo(mark) {
+        while (this.trail.length > mark) {
+            const [type, cx, dx] = this.trail.pop();
+
+            if (type === null) {
+                delete this.circuit.nodes[cx];
+                delete this.device.nodes[dx];
+                this.numNodes--;
+            } else {
+                delete this.circuit.components[type][cx];
+                delete this.device.components[type][dx];
+                this.numComponents--;
+            }
+        }
+    }
 
-        // Copy node maps
-        copy.circuit.nodes = {...this.circuit.nodes};
-        copy.device.nodes = {...this.device.nodes};
+    withNode(cx, dx) {
+        this.circuit.nodes[cx] = dx;
+        this.device.nodes[dx] = cx;
+        this.numNodes++;
 
-        // Add node
-        copy.circuit.nodes[cx] = dx;
-        copy.device.nodes[dx] = cx;
-        copy.numNodes = this.numNodes + 1;
+        this.trail.push([null, cx, dx]);
 
-        return copy;
+        return this;
     }
 
-    copyWithComponent(type, cx, dx) {
-        let copy = new State(this.types);
+    withComponent(type, cx, dx) {
+        this.circuit.components[type][cx] = dx;
+        this.device.components[type][dx] = cx;
+        this.numComponents++;
+
+        this.trail.push([type, cx, dx]);
 
-        // Use existing node maps
-        copy.circuit.nodes = this.circuit.nodes;
-        copy.device.nodes = this.device.nodes;
-        copy.numNodes = this.numNodes;
+        return this;
+    }
 
-        // Copy component maps
-        this.types.forEach(type => {
-            copy.circuit.components[type] = {...this.circuit.components[type]};
-            copy.device.components[type] = {...this.device.components[type]};
+    withTrail(trail) {
+        trail.forEach(([type, cx, dx]) => {
+            if (type === null) {
+                this.withNode(cx, dx);
+            } else {
+                this.withComponent(type, cx, dx);
+            }
         });
 
-        // Add component
-        copy.circuit.components[type][cx] = dx;
-        copy.device.components[type][dx] = cx;
-        copy.numComponents = this.numComponents + 1;
+        return this;
+    }
 
-        return copy;
+    getTrail() {
+        return this.trail;
     }
 
     getCircuitNode(cx) {
         return this.circuit.nodes[cx];
     }
 
+    getDeviceNodes() {
+        return Object.keys(this.device.nodes).map(Number);
+    }
+
+    getDeviceComponent(type, cx) {
+        return this.circuit.components[type][cx];
+    }
+
     getDeviceComponents(type) {
         return Object.values(this.circuit.components[type]);
     }
@@ -0,0 +1,72 @@
+export class Trace {
+
+    constructor() {
+
+        // Component attempts as flat [type, dx, parent, ok] records
+        this.frames = [];
+
+        // Node checks as flat [frame, dnx, cnx, ok] records
+        this.reads = [];
+
+        this.frame = -1;
+
+        // Set when the search depended on the whole device rather than the nodes read
+        this.global = false;
+    }
+
+    enter(type, dx) {
+        const frame = this.frames.length >> 2;
+
+        this.frames.push(type, dx, this.frame, 0);
+        this.frame = frame;
+
+        return frame;
+    }
+
+    leave(frame, ok) {
+        this.frames[(frame << 2) + 3] = ok ? 1 : 0;
+        this.frame = this.frames[(frame << 2) + 2];
+    }
+
+    read(dnx, cnx, ok) {
+        this.reads.push(this.frame, dnx, cnx, ok ? 1 : 0);
+    }
+
+    static isValid(device, circuit, frames, reads, since) {
+        const skip = new Uint8Array(frames.length >> 2);
+
+        // Attempts on components that were reduced since are only harmless if they failed
+        for (let f = 0; f < skip.length; f++) {
+            const type = frames[f << 2], dx = frames[(f << 2) + 1],
+                  parent = frames[(f << 2) + 2], ok = frames[(f << 2) + 3];
+
+            if (parent >= 0 && skip[parent]) {
+                skip[f] = 1;
+            } else if (!device.components.getComponent(type, dx)) {
+                if (ok) {
+                    return false;
+                }
+
+                skip[f] = 1;
+            }
+        }
+
+        // Remaining node checks must give the same answer, and must not have had components added
+        // that the search would have tried
+        for (let r = 0; r < reads.length; r += 4) {
+            const frame = reads[r], dnx = reads[r + 1], cnx = reads[r + 2], ok = reads[r + 3];
+
+            if (frame >= 0 && skip[frame]) {
+                continue;
+            }
+
+            if (since.changed(dnx) &&
+                (since.added(dnx, cnx) || device.canMatchNodes(circuit, cnx, dnx) !== (ok === 1))) {
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
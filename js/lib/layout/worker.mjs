@@ -0,0 +1,51 @@
+import { workerData } from 'worker_threads';
+
+import { Layout } from '../layout.mjs';
+import { Cache } from './cache.mjs';
+import { Matcher } from './matcher.mjs';
+import { State } from './state.mjs';
+import { Trace } from './trace.mjs';
+import { Components } from '../components.mjs';
+
+const { spec, signal, port } = workerData;
+
+// Mirror the unreduced device, which is kept in step with the main thread by applying its edits
+const device = new Layout(spec, {});
+const circuits = Layout.buildCircuits(spec);
+
+let epoch = 0;
+
+function evaluate(circuit, type, cx, dxs) {
+    return dxs.map(dx => {
+        const trace = new Trace(),
+              matcher = new Matcher(device, circuits[circuit], new Cache(), trace),
+              { match, state } = matcher.matchAnchor(type, cx, dx);
+
+        return {
+            dx,
+            epoch,
+            match,
+            trail: state ? state.getTrail() : null,
+            frames: trace.frames,
+            reads: trace.reads,
+            global: trace.global,
+        };
+    });
+}
+
+port.on('message', msg => {
+    try {
+        if (msg.op === 'apply') {
+            device.applyCircuit(circuits[msg.circuit], new State(Components.getTypes()).withTrail(msg.trail));
+            epoch++;
+        } else if (msg.op === 'evaluate') {
+            port.postMessage({ circuit: msg.circuit, results: evaluate(msg.circuit, msg.type, msg.cx, msg.dxs) });
+        }
+    } catch (e) {
+        port.postMessage({ error: e.message });
+    }
+
+    // Wake the main thread, which blocks while waiting for results
+    Atomics.add(signal, 0, 1);
+    Atomics.notify(signal, 0);
+});
@@ -0,0 +1,565 @@
+// Bit states
+const BIT_ZERO = 0;
+const BIT_ONE = 1;
+const BIT_Z = -1;
+const BIT_META = -2;
+
+// Signal levels
+const LEVEL_FLOAT = 0;
+const LEVEL_CAP = 1;
+const LEVEL_LOAD = 2;
+const LEVEL_POWER = 3;
+
+// Pull directions
+const PULL_DOWN = -1;
+const PULL_FLOAT = 0;
+const PULL_UP = 1;
+
+const RESOLVE_LIMIT = 50;
+
+// Emulates a compiled layout with the same resolution rules as icemu.c, so that layouts can be compared
+// from the compiler without generating and building C code
+export class Simulator {
+
+    constructor(layout) {
+        this.layout = layout;
+
+        const count = layout.counts.nodes;
+
+        this.level = new Int8Array(count);
+        this.pull = new Int8Array(count);
+        this.state = new Int8Array(count).fill(BIT_Z);
+        this.dirty = new Uint8Array(count);
+
+        this.on = layout.on.nodes[0];
+        this.off = layout.off.nodes[0];
+
+        this.level[this.on] = LEVEL_POWER;
+        this.pull[this.on] = PULL_UP;
+        this.state[this.on] = BIT_ONE;
+
+        this.level[this.off] = LEVEL_POWER;
+        this.pull[this.off] = PULL_DOWN;
+        this.state[this.off] = BIT_ZERO;
+
+        layout.loads.forEach(l => {
+            this.level[l.node] = LEVEL_LOAD;
+            this.pull[l.node] = l.type === 'on' ? PULL_UP : PULL_DOWN;
+        });
+
+        // Components in layout order, each with its own state and dirty flag
+        this.transistors = layout.transistors.map(t => ({ t, state: BIT_Z, dirty: false }));
+        this.buffers = layout.buffers.map(b => ({ b, dirty: false }));
+        this.functions = layout.functions.map(f => ({ f, dirty: false }));
+        this.cells = layout.cells.map(c => ({ c, state: BIT_Z, dirty: false }));
+        this.words = layout.words.map(w => ({ w, state: 0, latched: false, output: 0, driven: false, emitted: false, dirty: false }));
+        this.plas = layout.plas.map(p => ({ p, states: p.terms.map(() => BIT_Z), dirty: false }));
+        this.chains = layout.chains.map(ch => ({ ch, dirty: false }));
+        this.passes = layout.passes.map(p => ({ p, dirty: false }));
+        this.buses = layout.buses.map(b => ({ b, dirty: false }));
+        this.clocks = layout.clocks.map(c => ({ c, phase: null, step: 0, dirty: false }));
+
+        // Map nodes to the components that read them
+        this.gates = [...Array(count)].map(() => []);
+        this.channels = [...Array(count)].map(() => []);
+        this.readers = [...Array(count)].map(() => []);
+
+        this.transistors.forEach(t => {
+            this.gates[t.t.gate].push(t);
+
+            if (t.t.channel[0] !== t.t.channel[1]) {
+                t.t.channel.forEach(n => this.channels[n].push(t));
+            }
+        });
+
+        this.buffers.forEach(b => this.readers[b.b.input].push(b));
+        this.functions.forEach(f => new Set(f.f.inputs).forEach(n => this.readers[n].push(f)));
+        this.cells.forEach(c => new Set([...c.c.inputs, ...c.c.writes, ...c.c.reads]).forEach(n => this.readers[n].push(c)));
+        this.words.forEach(w => new Set(w.w.getInputNodes()).forEach(n => this.readers[n].push(w)));
+        this.plas.forEach(p => new Set(p.p.inputs).forEach(n => this.readers[n].push(p)));
+        this.chains.forEach(ch => new Set(ch.ch.getInputNodes()).forEach(n => this.readers[n].push(ch)));
+        this.passes.forEach(p => new Set(p.p.getInputNodes()).forEach(n => this.readers[n].push(p)));
+        this.buses.forEach(b => new Set(b.b.getInputNodes()).forEach(n => this.readers[n].push(b)));
+        this.clocks.forEach(c => this.readers[c.c.input].push(c));
+
+        // Readers of the outputs changed by each step of a clock edge are gathered into one block, and the
+        // readers of all outputs into another for when the tree is settled directly
+        const getBlock = nodes => ({
+            gates: [...new Set([].concat(...nodes.map(n => this.gates[n])))],
+            readers: [...new Set([].concat(...nodes.map(n => this.readers[n])))],
+        });
+
+        this.clocks.forEach(c => {
+            c.all = getBlock(c.c.getOutputNodes());
+            c.blocks = c.c.edges.map(steps => steps.map(changes => getBlock(changes.map(([k]) => c.c.outputs[k].output))));
+        });
+
+        // Apply initial loads to component outputs
+        this.buffers.forEach(b => this.applyOutput(b.b.output, this.getBufferOutput(b.b), b.b.logic, false));
+        this.functions.forEach(f => this.applyOutput(f.f.output, this.getFunctionOutput(f.f), f.f.logic, false));
+
+        this.cells.forEach(c => {
+            c.c.outputs.forEach((n, i) => this.applyOutput(n, i ? invert(BIT_Z) : BIT_Z, c.c.logic, false));
+        });
+
+        this.words.forEach(w => w.w.outputs.forEach(n => this.applyOutput(n, BIT_Z, w.w.logic, false)));
+
+        this.plas.forEach(p => {
+            const word = this.getPlaWord(p.p);
+
+            p.p.terms.forEach(([output, mask]) => {
+                this.applyOutput(output, mask.some(i => word & (1 << i)) ? BIT_ZERO : BIT_ONE, p.p.logic, false);
+            });
+        });
+
+        this.chains.forEach(ch => {
+            ch.ch.stages.forEach(f => this.applyOutput(f.output, this.getFunctionOutput(f), f.logic, false));
+        });
+
+        this.network = [];
+        this.networkSet = new Uint8Array(count);
+        this.levelUp = LEVEL_FLOAT;
+        this.levelDown = LEVEL_FLOAT;
+
+        // Resolution passes that hit the limit
+        this.incomplete = 0;
+    }
+
+    // --- Public ---
+
+    static getBitChar(bit) {
+        return { [BIT_ZERO]: '0', [BIT_ONE]: '1', [BIT_Z]: 'Z', [BIT_META]: 'M' }[bit];
+    }
+
+    getState(n) {
+        return this.state[n];
+    }
+
+    writeNode(n, bit) {
+        this.level[n] = LEVEL_LOAD;
+
+        if (bit === BIT_ZERO) {
+            this.pull[n] = PULL_DOWN;
+        } else if (bit === BIT_ONE) {
+            this.pull[n] = PULL_UP;
+        }
+
+        this.dirty[n] = 1;
+    }
+
+    writePin(pin, value) {
+        pin.nodes.forEach((n, i) => this.writeNode(n, (value >>> i) & 1));
+    }
+
+    sync() {
+        this.resolve();
+    }
+
+    // Take node states from another simulator, keeping transistors consistent with them so that stored
+    // charge is not disturbed, and re-evaluate the other components on the next sync
+    copyState(other, nodes) {
+        nodes.forEach(n => { this.state[n] = other.state[n]; });
+
+        this.transistors.forEach(t => {
+            t.state = this.getTransistorState(t.t);
+            t.dirty = false;
+        });
+
+        // Latches take the state their outputs show, since the other layout may keep it on a storage node
+        this.cells.forEach(c => {
+            const bit = c.c.outputs.length ? this.state[c.c.outputs[0]] : BIT_Z;
+
+            if (this.isEnabled(c.c.reads) && (bit === BIT_ZERO || bit === BIT_ONE)) {
+                c.state = bit;
+            }
+        });
+
+        [this.buffers, this.functions, this.cells, this.words, this.plas, this.chains, this.passes, this.buses, this.clocks].forEach(list => {
+            list.forEach(c => { c.dirty = true; });
+        });
+
+        // Copied clock trees are settled in the phase of their input
+        this.clocks.forEach(c => {
+            c.phase = this.getInput(c.c.input);
+            c.step = c.c.edges[c.phase].length;
+        });
+    }
+
+    // --- Private ---
+
+    resolve() {
+        for (let i = 0; i < RESOLVE_LIMIT; i++) {
+            for (let n = 0; n < this.dirty.length; n++) {
+                if (this.dirty[n]) {
+                    this.resolveNode(n);
+                }
+            }
+
+            let resolved = true;
+
+            this.transistors.forEach(t => {
+                if (t.dirty) {
+                    const state = this.getTransistorState(t.t);
+
+                    if (state !== t.state) {
+                        this.dirty[t.t.channel[0]] = 1;
+                        this.dirty[t.t.channel[1]] = 1;
+                    }
+
+                    t.state = state;
+                    t.dirty = false;
+                    resolved = false;
+                }
+            });
+
+            this.buffers.forEach(b => {
+                if (b.dirty) {
+                    this.applyOutput(b.b.output, this.getBufferOutput(b.b), b.b.logic, true);
+                    b.dirty = false;
+                    resolved = false;
+                }
+            });
+
+            this.functions.forEach(f => {
+                if (f.dirty) {
+                    this.applyOutput(f.f.output, this.getFunctionOutput(f.f), f.f.logic, true);
+                    f.dirty = false;
+                    resolved = false;
+                }
+            });
+
+            this.cells.forEach(c => {
+                if (c.dirty) {
+                    this.resolveCell(c);
+                    resolved = false;
+                }
+            });
+
+            this.words.forEach(w => {
+                if (w.dirty) {
+                    this.resolveWord(w);
+                    resolved = false;
+                }
+            });
+
+            this.plas.forEach(p => {
+                if (p.dirty) {
+                    this.resolvePla(p);
+                    resolved = false;
+                }
+            });
+
+            this.chains.forEach(ch => {
+                if (ch.dirty) {
+                    ch.ch.stages.forEach(f => {
+                        this.applyOutput(f.output, this.getFunctionOutput(f), f.logic, false);
+                        this.resolveNode(f.output);
+                    });
+
+                    ch.dirty = false;
+                    resolved = false;
+                }
+            });
+
+            this.passes.forEach(p => {
+                if (p.dirty) {
+                    this.resolvePass(p);
+                    resolved = false;
+                }
+            });
+
+            this.buses.forEach(b => {
+                if (b.dirty) {
+                    this.resolveBus(b);
+                    resolved = false;
+                }
+            });
+
+            this.clocks.forEach(c => {
+                if (c.dirty) {
+                    this.resolveClock(c);
+                    resolved = false;
+                }
+            });
+
+            if (resolved) {
+                return;
+            }
+        }
+
+        this.incomplete++;
+    }
+
+    resolveNode(n) {
+        this.levelUp = LEVEL_FLOAT;
+        this.levelDown = LEVEL_FLOAT;
+
+        this.addNetwork(n);
+
+        let state;
+
+        if (this.levelUp > this.levelDown) {
+            state = BIT_ONE;
+        } else if (this.levelDown > this.levelUp) {
+            state = BIT_ZERO;
+        } else if (this.levelUp < LEVEL_LOAD) {
+            state = BIT_Z;
+        } else {
+            state = BIT_META;
+        }
+
+        this.network.forEach(nn => {
+            if (state !== this.state[nn]) {
+                this.gates[nn].forEach(t => { t.dirty = true; });
+                this.readers[nn].forEach(c => { c.dirty = true; });
+            }
+
+            this.state[nn] = state;
+            this.dirty[nn] = 0;
+            this.networkSet[nn] = 0;
+        });
+
+        this.network = [];
+    }
+
+    addNetwork(start) {
+        const stack = [start];
+
+        while (stack.length) {
+            const n = stack.pop();
+
+            if (n === this.off) {
+                this.levelDown = LEVEL_POWER;
+                continue;
+            }
+
+            if (n === this.on) {
+                this.levelUp = LEVEL_POWER;
+                continue;
+            }
+
+            if (this.networkSet[n]) {
+                continue;
+            }
+
+            this.networkSet[n] = 1;
+            this.network.push(n);
+
+            const level = this.level[n], pull = this.pull[n], state = this.state[n];
+
+            if (pull === PULL_DOWN && level > this.levelDown) {
+                this.levelDown = level;
+            } else if (pull === PULL_UP && level > this.levelUp) {
+                this.levelUp = level;
+            } else if (state === BIT_ZERO && LEVEL_CAP > this.levelDown) {
+                this.levelDown = LEVEL_CAP;
+            } else if (state === BIT_ONE && LEVEL_CAP > this.levelUp) {
+                this.levelUp = LEVEL_CAP;
+            }
+
+            this.channels[n].forEach(t => {
+                if (t.state === BIT_ONE) {
+                    stack.push(t.t.channel[0] === n ? t.t.channel[1] : t.t.channel[0]);
+                }
+            });
+        }
+    }
+
+    applyOutput(n, bit, logic, dirty) {
+        this.level[n] = getLevel(bit, logic);
+        this.pull[n] = getPull(bit);
+
+        if (dirty) {
+            this.dirty[n] = 1;
+        }
+    }
+
+    getInput(n) {
+        return this.state[n] === BIT_ONE ? BIT_ONE : BIT_ZERO;
+    }
+
+    getTransistorState(t) {
+        const gate = this.state[t.gate];
+
+        return (t.type === 'nmos' ? gate === BIT_ONE : gate === BIT_ZERO) ? BIT_ONE : BIT_ZERO;
+    }
+
+    getBufferOutput(b) {
+        const input = this.getInput(b.input);
+
+        return b.inverting ? invert(input) : input;
+    }
+
+    getFunctionOutput(f) {
+        return f.evaluate(f.inputs.map(n => this.getInput(n)));
+    }
+
+    isEnabled(nodes) {
+        return nodes.every(n => this.getInput(n) === BIT_ONE);
+    }
+
+    resolveCell(c) {
+        if (this.isEnabled(c.c.writes) && c.c.inputs.length > 0) {
+            c.state = this.getInput(c.c.inputs[0]);
+        }
+
+        const output = this.isEnabled(c.c.reads) ? c.state : BIT_Z;
+
+        c.c.outputs.forEach((n, i) => this.applyOutput(n, i ? invert(output) : output, c.c.logic, true));
+
+        c.dirty = false;
+    }
+
+    resolveWord(w) {
+        if (this.isEnabled(w.w.writes)) {
+            w.state = w.w.inputs.reduce((word, n, i) => this.getInput(n) ? (word | (1 << i)) : word, 0);
+            w.latched = true;
+        }
+
+        const driven = w.latched && this.isEnabled(w.w.reads),
+              changed = (!w.emitted || driven !== w.driven) ? ~0 : driven ? w.state ^ w.output : 0;
+
+        w.driven = driven;
+        w.emitted = true;
+
+        w.w.outputs.forEach((n, i) => {
+            if (changed & (1 << i)) {
+                this.applyOutput(n, driven ? (w.state >> i) & 1 : BIT_Z, w.w.logic, true);
+            }
+        });
+
+        w.output = w.state;
+        w.dirty = false;
+    }
+
+    getPlaWord(p) {
+        return p.inputs.reduce((word, n, i) => this.getInput(n) ? (word | (1 << i)) : word, 0);
+    }
+
+    resolvePla(p) {
+        const word = this.getPlaWord(p.p);
+
+        p.p.terms.forEach(([output, mask], k) => {
+            const bit = mask.some(i => word & (1 << i)) ? BIT_ZERO : BIT_ONE;
+
+            if (bit !== p.states[k]) {
+                this.applyOutput(output, bit, p.p.logic, true);
+                p.states[k] = bit;
+            }
+        });
+
+        p.dirty = false;
+    }
+
+    // A closed pass gate drives its output from the input, pulling it down from a metastable one, otherwise the
+    // output keeps its charge. An input that has not been resolved yet is resolved first.
+    resolvePass(p) {
+        const input = this.state[p.p.input],
+              closed = this.getTransistorState(p.p) === BIT_ONE,
+              driven = closed && input !== BIT_Z;
+
+        if (closed && input === BIT_Z) {
+            this.dirty[p.p.input] = 1;
+        }
+
+        this.level[p.p.output] = driven ? LEVEL_LOAD : LEVEL_FLOAT;
+        this.pull[p.p.output] = driven ? (input === BIT_ONE ? PULL_UP : PULL_DOWN) : PULL_FLOAT;
+
+        if (driven) {
+            this.dirty[p.p.output] = 1;
+        }
+
+        p.dirty = false;
+    }
+
+    // A bus is pulled down by any closed discharge input, or else pulled up while precharged
+    resolveBus(b) {
+        const closed = n => this.state[n] === (b.b.type === 'nmos' ? BIT_ONE : BIT_ZERO),
+              up = closed(b.b.precharge),
+              down = b.b.discharges.some(closed);
+
+        this.level[b.b.output] = up || down ? LEVEL_POWER : LEVEL_FLOAT;
+        this.pull[b.b.output] = down ? PULL_DOWN : up ? PULL_UP : PULL_FLOAT;
+
+        if (up || down) {
+            this.dirty[b.b.output] = 1;
+        }
+
+        b.dirty = false;
+    }
+
+    // Replay the next step of a clock edge, or settle the whole tree if the phase is not known yet
+    resolveClock(c) {
+        const phase = this.getInput(c.c.input);
+
+        if (c.phase === null) {
+            const changed = c.c.outputs.map(o => this.applyClock(o, phase ? o.high : o.low)).some(Boolean);
+
+            if (changed) {
+                this.markBlock(c.all);
+            }
+
+            c.phase = phase;
+            c.step = c.c.edges[phase].length;
+        } else {
+            if (phase !== c.phase) {
+                c.phase = phase;
+                c.step = 0;
+            }
+
+            const steps = c.c.edges[phase];
+
+            if (c.step < steps.length) {
+                steps[c.step].forEach(([k, bit]) => this.applyClock(c.c.outputs[k], bit));
+
+                this.markBlock(c.blocks[phase][c.step]);
+
+                c.step++;
+            }
+        }
+
+        // Later steps run in the following iterations, as the tree they stand for would
+        c.dirty = c.step < c.c.edges[phase].length;
+    }
+
+    applyClock(o, bit) {
+        this.level[o.output] = getLevel(bit, o.logic);
+        this.pull[o.output] = getPull(bit);
+
+        if (this.state[o.output] === bit) {
+            return false;
+        }
+
+        this.state[o.output] = bit;
+
+        return true;
+    }
+
+    markBlock(block) {
+        block.gates.forEach(t => { t.dirty = true; });
+        block.readers.forEach(r => { r.dirty = true; });
+    }
+}
+
+// --- Private ---
+
+function invert(bit) {
+    return bit === BIT_ZERO ? BIT_ONE : bit === BIT_ONE ? BIT_ZERO : bit;
+}
+
+function getLevel(bit, logic) {
+    switch (bit) {
+        case BIT_ZERO:
+            return logic === 'pmos' ? LEVEL_LOAD : LEVEL_POWER;
+        case BIT_ONE:
+            return logic === 'nmos' ? LEVEL_LOAD : LEVEL_POWER;
+        case BIT_META:
+            return LEVEL_POWER;
+        default:
+            return LEVEL_FLOAT;
+    }
+}
+
+function getPull(bit) {
+    return bit === BIT_ZERO ? PULL_DOWN : bit === BIT_ONE ? PULL_UP : PULL_FLOAT;
+}
@@ -5,6 +5,12 @@ import { Transistor } from './components/transistor.mjs';
 import { Buffer } from './components/buffer.mjs';
 import { Function } from './components/function.mjs';
 import { Cell } from './components/cell.mjs';
+import { Pla } from './components/pla.mjs';
+import { Word } from './components/word.mjs';
+import { Chain } from './components/chain.mjs';
+import { Pass } from './components/pass.mjs';
+import { Bus } from './components/bus.mjs';
+import { Clock } from './components/clock.mjs';
 
 export class Spec {
 
@@ -150,6 +156,66 @@ export class Spec {
             this.cells = [];
         }
 
+        if (spec.plas) {
+            this.plas = Validator.validateArray(
+                'plas',
+                spec.plas,
+                Pla.validateSpec
+            );
+        } else {
+            this.plas = [];
+        }
+
+        if (spec.words) {
+            this.words = Validator.validateArray(
+                'words',
+                spec.words,
+                Word.validateSpec
+            );
+        } else {
+            this.words = [];
+        }
+
+        if (spec.chains) {
+            this.chains = Validator.validateArray(
+                'chains',
+                spec.chains,
+                Chain.validateSpec
+            );
+        } else {
+            this.chains = [];
+        }
+
+        if (spec.passes) {
+            this.passes = Validator.validateArray(
+                'passes',
+                spec.passes,
+                Pass.validateSpec
+            );
+        } else {
+            this.passes = [];
+        }
+
+        if (spec.buses) {
+            this.buses = Validator.validateArray(
+                'buses',
+                spec.buses,
+                Bus.validateSpec
+            );
+        } else {
+            this.buses = [];
+        }
+
+        if (spec.clocks) {
+            this.clocks = Validator.validateArray(
+                'clocks',
+                spec.clocks,
+                Clock.validateSpec
+            );
+        } else {
+            this.clocks = [];
+        }
+
         // Circuits
         if (spec.circuits) {
             this.circuits = Validator.validateArray('circuits', spec.circuits, (field, val) => {
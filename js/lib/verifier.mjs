@@ -0,0 +1,214 @@
+import { Layout } from './layout.mjs';
+import { Simulator } from './simulator.mjs';
+
+// Half-cycles to hold the reset pin low before running
+const RESET_STEPS = 16;
+
+// Chance per half-cycle that a single-bit input other than the clock or reset toggles
+const TOGGLE_RATE = 1 / 64;
+
+// Internal nodes to list with a divergence
+const MAX_NODES = 8;
+
+export class Verifier {
+
+    constructor(spec, options) {
+        this.spec = spec;
+        this.options = options;
+
+        this.cycles = options.cycles;
+        this.seed = options.seed;
+        this.clock = options.clock;
+        this.reset = options.reset;
+
+        // Reductions in the order the compiler applies them
+        this.circuits = spec.circuits.filter(c => c.enabled && !(c.limit <= 0));
+        this.passes = ['propagateConstants', 'collapseBuffers', 'buildClockTree', 'buildPasses', 'buildBuses', 'buildPlas', 'buildWords', 'buildChains'].filter(p => options.layout[p]);
+    }
+
+    // Compare the fully reduced layout against the unreduced netlist, returning the first divergence
+    verify() {
+        return this.compare(this.circuits.length, this.passes.length);
+    }
+
+    // Narrow a divergence down to the first circuit instance or compiler pass that introduces it
+    bisect() {
+        if (!this.compare(this.circuits.length, 0)) {
+            const count = this.search(1, this.passes.length, k => this.compare(this.circuits.length, k));
+
+            return { pass: this.passes[count - 1], divergence: this.compare(this.circuits.length, count) };
+        }
+
+        const count = this.search(1, this.circuits.length, k => this.compare(k, 0)),
+              circuit = this.circuits[count - 1];
+
+        // The instance limit counts reductions of the last circuit, so it can be searched the same way
+        const max = this.getReductionCount(count),
+              limit = this.search(1, max, m => this.compare(count, 0, m));
+
+        return { circuit: circuit, instance: limit, divergence: this.compare(count, 0, limit) };
+    }
+
+    // --- Private ---
+
+    // Find the smallest count in [lo, hi] for which the test diverges, given that hi diverges
+    search(lo, hi, test) {
+        while (lo < hi) {
+            const mid = (lo + hi) >> 1;
+
+            if (test(mid)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+
+        return lo;
+    }
+
+    // Build a layout with the first circuits and passes, optionally limiting instances of the last circuit
+    buildLayout(circuits, passes, limit) {
+        const spec = Object.assign(Object.create(Object.getPrototypeOf(this.spec)), this.spec, {
+            circuits: this.circuits.slice(0, circuits).map((c, i) => {
+                return (limit !== undefined && i === circuits - 1) ?
+                    Object.assign(Object.create(Object.getPrototypeOf(c)), c, { limit: limit }) : c;
+            }),
+        });
+
+        const options = {
+            reduceNodes: false,
+            reduceCircuits: circuits > 0,
+            jobs: this.options.layout.jobs,
+            orderNodes: 'none',
+            clock: this.clock,
+        };
+
+        this.passes.slice(0, passes).forEach(p => { options[p] = true; });
+
+        return new Layout(spec, options);
+    }
+
+    getReductionCount(circuits) {
+        return Math.max(1, this.buildLayout(circuits, 0).reductions[circuits - 1]);
+    }
+
+    compare(circuits, passes, limit) {
+        const key = JSON.stringify([circuits, passes, limit]);
+
+        this.results = this.results || {};
+
+        if (!(key in this.results)) {
+            if (!this.reference) {
+                this.reference = this.buildLayout(0, 0);
+            }
+
+            this.results[key] = run(this.reference, this.buildLayout(circuits, passes, limit), this);
+        }
+
+        return this.results[key];
+    }
+}
+
+// --- Private ---
+
+// Drive two layouts with the same random inputs and report the first step where they disagree
+function run(reference, candidate, { cycles, seed, clock, reset }) {
+    const random = mulberry32(seed),
+          sims = [new Simulator(reference), new Simulator(candidate)];
+
+    const inputs = reference.pins.filter(p => p.type === 'pin' && p.writable),
+          outputs = reference.pins.filter(p => p.readable && p.type !== 'src'),
+          clockPin = inputs.find(p => p.id === clock && p.nodes.length === 1),
+          resetPin = inputs.find(p => p.id === reset && p.nodes.length === 1);
+
+    // Only nodes kept by both layouts can be compared, and the candidate keeps the original node numbers
+    const shared = Object.keys(candidate.nodes).map(Number).filter(n => n in reference.nodes);
+
+    const values = new Map(inputs.map(p => [p, p.nodes.length === 1 ? 1 : 0]));
+
+    let nodeDivergence = null;
+
+    for (let step = 0; step < cycles * 2; step++) {
+
+        // Storage nodes that reset leaves alone keep power-on values that depend on evaluation order,
+        // so the candidate starts from the reference's state once reset has run
+        if (step === RESET_STEPS * 2) {
+            sims[1].copyState(sims[0], shared);
+        }
+
+        // The clock toggles every half-cycle and reset is held low to start. Other single-bit inputs toggle
+        // now and then, and multi-bit inputs take a random value every half-cycle.
+        inputs.forEach(p => {
+            if (p === clockPin) {
+                values.set(p, step & 1);
+            } else if (p === resetPin) {
+                values.set(p, step < RESET_STEPS ? 0 : 1);
+            } else if (p.nodes.length === 1) {
+                values.set(p, random() < TOGGLE_RATE ? values.get(p) ^ 1 : values.get(p));
+            } else {
+                values.set(p, Math.floor(random() * 2 ** p.nodes.length));
+            }
+        });
+
+        sims.forEach(sim => {
+            inputs.forEach(p => sim.writePin(p, values.get(p)));
+            sim.sync();
+        });
+
+        if (step < RESET_STEPS * 2) {
+            continue;
+        }
+
+        // Internal nodes usually diverge before any pin does, so remember the first to point at the cause
+        if (!nodeDivergence) {
+            const nodes = shared.filter(n => sims[0].getState(n) !== sims[1].getState(n));
+
+            if (nodes.length) {
+                nodeDivergence = {
+                    step: step,
+                    nodes: nodes.slice(0, MAX_NODES).map(n => describeNode(reference, n, sims)),
+                    count: nodes.length,
+                };
+            }
+        }
+
+        for (const p of outputs) {
+            const bit = p.nodes.findIndex(n => sims[0].getState(n) !== sims[1].getState(n));
+
+            if (bit >= 0) {
+                return {
+                    step: step,
+                    cycle: step >> 1,
+                    pin: p.nodes.length === 1 ? p.id : `${p.id}[${bit}]`,
+                    states: sims.map(sim => sim.getState(p.nodes[bit])),
+                    inputs: Object.fromEntries(inputs.map(p => [p.id, values.get(p)])),
+                    first: nodeDivergence,
+                };
+            }
+        }
+    }
+
+    return null;
+}
+
+function describeNode(layout, n, sims) {
+    const names = Object.entries(layout.spec.nodeNames).filter(([, nodes]) => nodes.includes(n)).map(([name]) => name);
+
+    return { node: n, names: names, states: sims.map(sim => sim.getState(n)) };
+}
+
+// Small seeded generator, so a divergence can be reproduced from its seed
+function mulberry32(seed) {
+    let a = seed >>> 0;
+
+    return () => {
+        a = (a + 0x6D2B79F5) >>> 0;
+
+        let t = a;
+
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
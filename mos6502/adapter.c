@@ -83,6 +83,15 @@ static value_t adapter_instance_read_pin(const void * instance, const char * pin
 static void adapter_instance_write_pin(void * instance, const char * pin, unsigned int data);
 static value_t adapter_instance_read_mem(const void * instance, unsigned int addr);
 static void adapter_instance_write_mem(void * instance, unsigned int addr, unsigned int data);
+static void adapter_instance_read_mem_block(const void * instance, unsigned int addr,
+                                            unsigned char * data, size_t count);
+static void adapter_instance_write_mem_block(void * instance, unsigned int addr,
+                                             const unsigned char * data, size_t count);
+static const unsigned char * adapter_instance_get_mem(const void * instance, unsigned int addr,
+                                                      size_t * count);
+static int adapter_instance_resolve_pin(const void * instance, const char * pin);
+static value_t adapter_instance_read_pin_handle(const void * instance, int pin);
+static void adapter_instance_write_pin_handle(void * instance, int pin, unsigned int data);
 
 /* --- Adapter singleton --- */
 
@@ -102,6 +111,12 @@ static const adapter_t MOS6502_ADAPTER = {
     adapter_instance_write_pin,
     adapter_instance_read_mem,
     adapter_instance_write_mem,
+    adapter_instance_read_mem_block,
+    adapter_instance_write_mem_block,
+    adapter_instance_get_mem,
+    adapter_instance_resolve_pin,
+    adapter_instance_read_pin_handle,
+    adapter_instance_write_pin_handle,
 };
 
 /* --- Public functions --- */
@@ -285,6 +300,119 @@ void adapter_instance_write_pin(void * instance, const char * pin, unsigned int
     }
 }
 
+int adapter_instance_resolve_pin(const void * instance, const char * pin) {
+    size_t offset = 0;
+    size_t i;
+
+    for (i = 0; i < MOS6502_PIN_16_COUNT; i++) {
+        if (strcmp(pin, MOS6502_PIN_16_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    offset += MOS6502_PIN_16_COUNT;
+
+    for (i = 0; i < MOS6502_PIN_8_COUNT; i++) {
+        if (strcmp(pin, MOS6502_PIN_8_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    offset += MOS6502_PIN_8_COUNT;
+
+    for (i = 0; i < MOS6502_PIN_1_COUNT; i++) {
+        if (strcmp(pin, MOS6502_PIN_1_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    return -1;
+}
+
+value_t adapter_instance_read_pin_handle(const void * instance, int pin) {
+    const mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
+
+    value_t val = { 0, 0, 0 };
+    size_t i = (size_t)pin;
+
+    if (pin < 0) {
+        return val;
+    }
+
+    if (i < MOS6502_PIN_16_COUNT) {
+        if (MOS6502_PIN_16_MAP[i].read_func != NULL) {
+            val.data = MOS6502_PIN_16_MAP[i].read_func(mos6502_instance->mos6502);
+            val.bits = 16;
+            val.base = MOS6502_PIN_16_MAP[i].base;
+        }
+
+        return val;
+    }
+
+    i -= MOS6502_PIN_16_COUNT;
+
+    if (i < MOS6502_PIN_8_COUNT) {
+        if (MOS6502_PIN_8_MAP[i].read_func != NULL) {
+            val.data = MOS6502_PIN_8_MAP[i].read_func(mos6502_instance->mos6502);
+            val.bits = 8;
+            val.base = MOS6502_PIN_8_MAP[i].base;
+        }
+
+        return val;
+    }
+
+    i -= MOS6502_PIN_8_COUNT;
+
+    if (i < MOS6502_PIN_1_COUNT) {
+        if (MOS6502_PIN_1_MAP[i].read_func != NULL) {
+            val.data = MOS6502_PIN_1_MAP[i].read_func(mos6502_instance->mos6502);
+            val.bits = 1;
+            val.base = 10;
+        }
+
+        return val;
+    }
+
+    return val;
+}
+
+void adapter_instance_write_pin_handle(void * instance, int pin, unsigned int data) {
+    mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
+    size_t i = (size_t)pin;
+
+    if (pin < 0) {
+        return;
+    }
+
+    if (i < MOS6502_PIN_16_COUNT) {
+        if (MOS6502_PIN_16_MAP[i].write_func != NULL) {
+            MOS6502_PIN_16_MAP[i].write_func(mos6502_instance->mos6502, data, true);
+        }
+
+        return;
+    }
+
+    i -= MOS6502_PIN_16_COUNT;
+
+    if (i < MOS6502_PIN_8_COUNT) {
+        if (MOS6502_PIN_8_MAP[i].write_func != NULL) {
+            MOS6502_PIN_8_MAP[i].write_func(mos6502_instance->mos6502, data, true);
+        }
+
+        return;
+    }
+
+    i -= MOS6502_PIN_8_COUNT;
+
+    if (i < MOS6502_PIN_1_COUNT) {
+        if (MOS6502_PIN_1_MAP[i].write_func != NULL) {
+            MOS6502_PIN_1_MAP[i].write_func(mos6502_instance->mos6502, data, true);
+        }
+
+        return;
+    }
+}
+
 value_t adapter_instance_read_mem(const void * instance, unsigned int addr) {
     const mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
 
@@ -302,3 +430,24 @@ void adapter_instance_write_mem(void * instance, unsigned int addr, unsigned int
 
     mos6502_memory_write(mos6502_instance->memory, addr, data);
 }
+
+void adapter_instance_read_mem_block(const void * instance, unsigned int addr,
+                                     unsigned char * data, size_t count) {
+    const mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
+
+    mos6502_memory_read_block(mos6502_instance->memory, addr, data, count);
+}
+
+void adapter_instance_write_mem_block(void * instance, unsigned int addr,
+                                      const unsigned char * data, size_t count) {
+    mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
+
+    mos6502_memory_write_block(mos6502_instance->memory, addr, data, count);
+}
+
+const unsigned char * adapter_instance_get_mem(const void * instance, unsigned int addr,
+                                               size_t * count) {
+    const mos6502_instance_t * mos6502_instance = (mos6502_instance_t *)instance;
+
+    return mos6502_memory_data(mos6502_instance->memory, addr, count);
+}
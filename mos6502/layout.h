@@ -150,6 +150,20 @@ const size_t MOS6502_TRANSISTOR_COUNT = 993;
 const size_t MOS6502_BUFFER_COUNT = 435;
 const size_t MOS6502_FUNCTION_COUNT = 451;
 const size_t MOS6502_CELL_COUNT = 16;
+const size_t MOS6502_WORD_COUNT = 0;
+const size_t MOS6502_PLA_COUNT = 0;
+const size_t MOS6502_PLA_TERM_COUNT = 0;
+const size_t MOS6502_CHAIN_COUNT = 0;
+const size_t MOS6502_CHAIN_STAGE_COUNT = 0;
+const size_t MOS6502_PASS_COUNT = 0;
+const size_t MOS6502_BUS_COUNT = 0;
+const size_t MOS6502_CLOCK_COUNT = 0;
+const size_t MOS6502_CLOCK_OUTPUT_COUNT = 0;
+const size_t MOS6502_CLOCK_STEP_COUNT = 0;
+const size_t MOS6502_CLOCK_CHANGE_COUNT = 0;
+const size_t MOS6502_CCC_COUNT = 311;
+const size_t MOS6502_CCC_NODE_COUNT = 827;
+const size_t MOS6502_CCC_TRANSISTOR_COUNT = 990;
 
 /* --- Function definitions --- */
 
@@ -2115,4 +2129,948 @@ const cell_t MOS6502_CELL_DEFS[] = {
     {LOGIC_TTL, CELL_D_LATCH, {1651}, 1, {1443}, 1, {710, 821}, 2, {0}, 0}
 };
 
+/* --- Channel-connected components --- */
+
+const ccc_t MOS6502_CCC_DEFS[] = {
+    {0, 24, 0, 43},
+    {24, 23, 43, 41},
+    {47, 1, 84, 3},
+    {48, 1, 87, 1},
+    {49, 2, 88, 5},
+    {51, 24, 93, 42},
+    {75, 2, 135, 1},
+    {77, 2, 136, 2},
+    {79, 2, 138, 1},
+    {81, 3, 139, 3},
+    {84, 2, 142, 1},
+    {86, 2, 143, 2},
+    {88, 48, 145, 56},
+    {136, 2, 201, 2},
+    {138, 4, 203, 3},
+    {142, 2, 206, 1},
+    {144, 2, 207, 1},
+    {146, 5, 208, 7},
+    {151, 2, 215, 1},
+    {153, 1, 216, 3},
+    {154, 2, 219, 1},
+    {156, 1, 220, 3},
+    {157, 1, 223, 2},
+    {158, 2, 225, 1},
+    {160, 2, 226, 1},
+    {162, 2, 227, 1},
+    {164, 1, 228, 4},
+    {165, 23, 232, 41},
+    {188, 2, 273, 1},
+    {190, 24, 274, 43},
+    {214, 23, 317, 42},
+    {237, 3, 359, 2},
+    {240, 3, 361, 4},
+    {243, 2, 365, 1},
+    {245, 3, 366, 2},
+    {248, 3, 368, 3},
+    {251, 3, 371, 2},
+    {254, 4, 373, 3},
+    {258, 2, 376, 1},
+    {260, 1, 377, 2},
+    {261, 2, 379, 1},
+    {263, 2, 380, 1},
+    {265, 2, 381, 1},
+    {267, 2, 382, 1},
+    {269, 24, 383, 42},
+    {293, 2, 425, 1},
+    {295, 2, 426, 2},
+    {297, 2, 428, 1},
+    {299, 1, 429, 2},
+    {300, 2, 431, 1},
+    {302, 2, 432, 1},
+    {304, 2, 433, 1},
+    {306, 2, 434, 1},
+    {308, 4, 435, 3},
+    {312, 2, 438, 2},
+    {314, 2, 440, 1},
+    {316, 1, 441, 2},
+    {317, 1, 443, 1},
+    {318, 1, 444, 3},
+    {319, 2, 447, 2},
+    {321, 2, 449, 1},
+    {323, 2, 450, 1},
+    {325, 2, 451, 1},
+    {327, 3, 452, 5},
+    {330, 2, 457, 1},
+    {332, 2, 458, 1},
+    {334, 1, 459, 2},
+    {335, 2, 461, 1},
+    {337, 2, 462, 1},
+    {339, 2, 463, 4},
+    {341, 4, 467, 3},
+    {345, 2, 470, 1},
+    {347, 2, 471, 1},
+    {349, 2, 472, 1},
+    {351, 4, 473, 3},
+    {355, 2, 476, 1},
+    {357, 2, 477, 1},
+    {359, 3, 478, 4},
+    {362, 24, 482, 42},
+    {386, 4, 524, 4},
+    {390, 2, 528, 2},
+    {392, 2, 530, 1},
+    {394, 1, 531, 2},
+    {395, 2, 533, 1},
+    {397, 2, 534, 1},
+    {399, 3, 535, 2},
+    {402, 2, 537, 1},
+    {404, 6, 538, 7},
+    {410, 2, 545, 6},
+    {412, 2, 551, 1},
+    {414, 3, 552, 3},
+    {417, 3, 555, 2},
+    {420, 2, 557, 2},
+    {422, 2, 559, 1},
+    {424, 1, 560, 1},
+    {425, 1, 561, 3},
+    {426, 4, 564, 6},
+    {430, 2, 570, 1},
+    {432, 2, 571, 1},
+    {434, 2, 572, 1},
+    {436, 1, 573, 4},
+    {437, 2, 577, 2},
+    {439, 2, 579, 1},
+    {441, 2, 580, 2},
+    {443, 2, 582, 1},
+    {445, 4, 583, 3},
+    {449, 2, 586, 2},
+    {451, 4, 588, 5},
+    {455, 1, 593, 2},
+    {456, 2, 595, 1},
+    {458, 2, 596, 1},
+    {460, 2, 597, 1},
+    {462, 3, 598, 3},
+    {465, 1, 601, 1},
+    {466, 2, 602, 1},
+    {468, 1, 603, 3},
+    {469, 2, 606, 1},
+    {471, 2, 607, 1},
+    {473, 2, 608, 3},
+    {475, 2, 611, 1},
+    {477, 2, 612, 1},
+    {479, 2, 613, 1},
+    {481, 2, 614, 1},
+    {483, 4, 615, 5},
+    {487, 2, 620, 2},
+    {489, 1, 622, 4},
+    {490, 2, 626, 1},
+    {492, 1, 627, 2},
+    {493, 2, 629, 1},
+    {495, 1, 630, 2},
+    {496, 1, 632, 1},
+    {497, 3, 633, 3},
+    {500, 1, 636, 4},
+    {501, 2, 640, 1},
+    {503, 2, 641, 1},
+    {505, 2, 642, 1},
+    {507, 2, 643, 1},
+    {509, 2, 644, 1},
+    {511, 2, 645, 1},
+    {513, 2, 646, 2},
+    {515, 1, 648, 3},
+    {516, 3, 651, 3},
+    {519, 2, 654, 1},
+    {521, 2, 655, 3},
+    {523, 3, 658, 4},
+    {526, 2, 662, 1},
+    {528, 2, 663, 1},
+    {530, 2, 664, 1},
+    {532, 2, 665, 1},
+    {534, 2, 666, 1},
+    {536, 2, 667, 1},
+    {538, 2, 668, 2},
+    {540, 4, 670, 5},
+    {544, 2, 675, 1},
+    {546, 2, 676, 2},
+    {548, 1, 678, 3},
+    {549, 2, 681, 1},
+    {551, 2, 682, 2},
+    {553, 2, 684, 1},
+    {555, 2, 685, 1},
+    {557, 2, 686, 1},
+    {559, 1, 687, 4},
+    {560, 3, 691, 2},
+    {563, 1, 693, 2},
+    {564, 4, 695, 3},
+    {568, 1, 698, 4},
+    {569, 3, 702, 4},
+    {572, 2, 706, 1},
+    {574, 2, 707, 1},
+    {576, 2, 708, 1},
+    {578, 4, 709, 5},
+    {582, 2, 714, 2},
+    {584, 2, 716, 1},
+    {586, 2, 717, 1},
+    {588, 2, 718, 7},
+    {590, 3, 725, 5},
+    {593, 3, 730, 4},
+    {596, 1, 734, 3},
+    {597, 2, 737, 1},
+    {599, 1, 738, 1},
+    {600, 3, 739, 3},
+    {603, 2, 742, 1},
+    {605, 1, 743, 3},
+    {606, 1, 746, 2},
+    {607, 2, 748, 1},
+    {609, 1, 749, 4},
+    {610, 2, 753, 2},
+    {612, 2, 755, 1},
+    {614, 2, 756, 1},
+    {616, 2, 757, 1},
+    {618, 2, 758, 1},
+    {620, 2, 759, 1},
+    {622, 3, 760, 2},
+    {625, 2, 762, 1},
+    {627, 2, 763, 1},
+    {629, 2, 764, 1},
+    {631, 2, 765, 2},
+    {633, 2, 767, 1},
+    {635, 1, 768, 2},
+    {636, 2, 770, 1},
+    {638, 1, 771, 1},
+    {639, 2, 772, 2},
+    {641, 1, 774, 4},
+    {642, 3, 778, 4},
+    {645, 2, 782, 1},
+    {647, 1, 783, 1},
+    {648, 2, 784, 1},
+    {650, 3, 785, 4},
+    {653, 2, 789, 1},
+    {655, 2, 790, 3},
+    {657, 1, 793, 3},
+    {658, 2, 796, 1},
+    {660, 1, 797, 3},
+    {661, 1, 800, 4},
+    {662, 1, 804, 1},
+    {663, 3, 805, 4},
+    {666, 2, 809, 1},
+    {668, 2, 810, 1},
+    {670, 2, 811, 2},
+    {672, 1, 813, 4},
+    {673, 2, 817, 1},
+    {675, 3, 818, 4},
+    {678, 1, 822, 4},
+    {679, 2, 826, 1},
+    {681, 2, 827, 1},
+    {683, 2, 828, 1},
+    {685, 2, 829, 1},
+    {687, 1, 830, 4},
+    {688, 2, 834, 1},
+    {690, 2, 835, 2},
+    {692, 4, 837, 3},
+    {696, 2, 840, 1},
+    {698, 1, 841, 2},
+    {699, 1, 843, 2},
+    {700, 2, 845, 1},
+    {702, 2, 846, 1},
+    {704, 2, 847, 1},
+    {706, 2, 848, 1},
+    {708, 2, 849, 4},
+    {710, 2, 853, 1},
+    {712, 1, 854, 1},
+    {713, 2, 855, 1},
+    {715, 1, 856, 4},
+    {716, 2, 860, 3},
+    {718, 1, 863, 2},
+    {719, 2, 865, 1},
+    {721, 1, 866, 1},
+    {722, 2, 867, 1},
+    {724, 2, 868, 1},
+    {726, 2, 869, 1},
+    {728, 1, 870, 1},
+    {729, 2, 871, 1},
+    {731, 2, 872, 1},
+    {733, 2, 873, 1},
+    {735, 1, 874, 4},
+    {736, 2, 878, 1},
+    {738, 1, 879, 3},
+    {739, 1, 882, 3},
+    {740, 4, 885, 3},
+    {744, 2, 888, 1},
+    {746, 2, 889, 1},
+    {748, 2, 890, 1},
+    {750, 3, 891, 4},
+    {753, 3, 895, 8},
+    {756, 1, 903, 2},
+    {757, 1, 905, 5},
+    {758, 2, 910, 1},
+    {760, 3, 911, 8},
+    {763, 1, 919, 1},
+    {764, 2, 920, 1},
+    {766, 2, 921, 1},
+    {768, 2, 922, 1},
+    {770, 2, 923, 1},
+    {772, 2, 924, 1},
+    {774, 1, 925, 2},
+    {775, 1, 927, 2},
+    {776, 2, 929, 1},
+    {778, 2, 930, 1},
+    {780, 1, 931, 4},
+    {781, 2, 935, 1},
+    {783, 2, 936, 1},
+    {785, 1, 937, 2},
+    {786, 2, 939, 1},
+    {788, 1, 940, 4},
+    {789, 2, 944, 1},
+    {791, 1, 945, 1},
+    {792, 2, 946, 1},
+    {794, 2, 947, 1},
+    {796, 1, 948, 1},
+    {797, 1, 949, 3},
+    {798, 1, 952, 1},
+    {799, 1, 953, 4},
+    {800, 2, 957, 1},
+    {802, 1, 958, 2},
+    {803, 2, 960, 1},
+    {805, 1, 961, 2},
+    {806, 1, 963, 2},
+    {807, 2, 965, 1},
+    {809, 1, 966, 2},
+    {810, 2, 968, 1},
+    {812, 2, 969, 1},
+    {814, 2, 970, 1},
+    {816, 1, 971, 2},
+    {817, 1, 973, 3},
+    {818, 1, 976, 3},
+    {819, 2, 979, 1},
+    {821, 1, 980, 1},
+    {822, 1, 981, 2},
+    {823, 2, 983, 1},
+    {825, 1, 984, 2},
+    {826, 1, 986, 4}
+};
+
+const nx_t MOS6502_CCC_NODES[] = {
+    1, 81, 450, 458, 481, 502, 573, 655, 704, 978, 1066, 1242, 1287, 1332, 1389, 1421, 1424, 1473, 1491, 1496, 1618, 1637, 1651, 1694,
+    3, 27, 85, 208, 436, 478, 606, 658, 727, 892, 900, 948, 989, 1095, 1119, 1142, 1160, 1306, 1344, 1405, 1437, 1645, 1702,
+    7,
+    9,
+    11, 55,
+    13, 77, 115, 121, 235, 326, 331, 351, 377, 448, 518, 618, 652, 679, 833, 1014, 1116, 1136, 1212, 1336, 1458, 1551, 1627, 1724,
+    14, 294,
+    15, 474,
+    17, 554,
+    18, 468, 1703,
+    19, 899,
+    20, 993,
+    22, 68, 143, 155, 177, 250, 274, 276, 277, 296, 304, 308, 336, 350, 371, 394, 404, 477, 486, 495, 532, 649, 651, 681, 697, 701, 722, 740, 841, 884, 893, 953, 957, 965, 1063, 1071, 1084, 1123, 1197, 1318, 1398, 1459, 1469, 1490, 1525, 1628, 1632, 1691,
+    24, 1039,
+    26, 227, 703, 927,
+    29, 561,
+    31, 1051,
+    32, 186, 455, 1082, 1692,
+    34, 828,
+    37,
+    40, 1575,
+    42,
+    43,
+    44, 90,
+    45, 1712,
+    47, 420,
+    48,
+    49, 72, 166, 240, 263, 280, 314, 483, 530, 578, 589, 615, 622, 733, 831, 858, 1098, 1301, 1383, 1387, 1503, 1630, 1678,
+    50, 1350,
+    52, 87, 98, 183, 209, 292, 583, 694, 767, 870, 872, 929, 976, 991, 1009, 1022, 1148, 1150, 1234, 1248, 1282, 1432, 1444, 1709,
+    54, 64, 146, 332, 401, 407, 413, 488, 564, 624, 687, 719, 737, 977, 1108, 1139, 1167, 1169, 1216, 1403, 1597, 1670, 1722,
+    56, 398, 824,
+    57, 114, 1402,
+    62, 1690,
+    67, 449, 1036,
+    69, 648, 1181,
+    73, 934, 968,
+    74, 895, 1309, 1675,
+    80, 1333,
+    82,
+    88, 522,
+    93, 758,
+    94, 1650,
+    95, 1375,
+    96, 141, 162, 242, 305, 315, 439, 464, 584, 684, 723, 998, 1188, 1302, 1359, 1414, 1475, 1531, 1532, 1621, 1648, 1654, 1661, 1680,
+    99, 1194,
+    100, 1205,
+    101, 1141,
+    102,
+    104, 1221,
+    109, 1161,
+    111, 955,
+    116, 718,
+    119, 237, 702, 1641,
+    126, 1486,
+    132, 1321,
+    135,
+    142,
+    147,
+    150, 613,
+    151, 440,
+    158, 789,
+    160, 1049,
+    164, 333, 1030,
+    169, 1008,
+    170, 1117,
+    175,
+    176, 598,
+    181, 548,
+    182, 265,
+    187, 402, 759, 1579,
+    188, 1373,
+    190, 1101,
+    191, 456,
+    194, 310, 409, 724,
+    197, 944,
+    199, 327,
+    202, 629, 760,
+    205, 391, 423, 493, 721, 765, 777, 843, 871, 1001, 1147, 1206, 1251, 1299, 1370, 1435, 1494, 1522, 1535, 1539, 1592, 1611, 1647, 1653,
+    206, 430, 465, 1570,
+    207, 1061,
+    213, 576,
+    214,
+    215, 1379,
+    222, 1687,
+    223, 1215, 1528,
+    226, 1093,
+    248, 902, 1272, 1276, 1624, 1679,
+    252, 338,
+    261, 729,
+    262, 1447, 1598,
+    264, 799, 1693,
+    266, 1037,
+    272, 1162,
+    297,
+    298,
+    299, 1470, 1625, 1723,
+    306, 581,
+    318, 1607,
+    323, 959,
+    325,
+    330, 675,
+    334, 1078,
+    339, 632,
+    340, 1283,
+    343, 571, 1182, 1300,
+    345, 1279,
+    348, 1445, 1495, 1546,
+    353,
+    357, 728,
+    360, 795,
+    361, 1319,
+    363, 1091, 1360,
+    366,
+    369, 1075,
+    373,
+    374, 1669,
+    378, 940,
+    379, 1480,
+    385, 1652,
+    389, 614,
+    393, 1179,
+    396, 796,
+    405, 596, 1085, 1172,
+    408, 1308,
+    414,
+    415, 1196,
+    417,
+    418, 983,
+    421,
+    427,
+    428, 644, 1558,
+    437,
+    442, 509,
+    443, 513,
+    457, 823,
+    459, 844,
+    460, 616,
+    462, 878,
+    469, 875,
+    471,
+    472, 1366, 1606,
+    473, 848,
+    480, 1092,
+    484, 536, 914,
+    490, 1516,
+    496, 601,
+    498, 568,
+    501, 1713,
+    504, 1438,
+    506, 1602,
+    508, 1303,
+    511, 845, 1550, 1553,
+    512, 1130,
+    515, 1411,
+    520,
+    521, 1358,
+    526, 1500,
+    527, 1474,
+    529, 588,
+    533, 599,
+    534,
+    537, 862, 1011,
+    539,
+    541, 1183, 1320, 1605,
+    549,
+    557, 1073, 1326,
+    559, 608,
+    560, 808,
+    562, 645,
+    566, 627, 661, 802,
+    586, 832,
+    590, 1178,
+    597, 1339,
+    604, 1477,
+    605, 779, 805,
+    610, 696, 911,
+    612,
+    621, 1586,
+    623,
+    626, 756, 1249,
+    633, 1059,
+    643,
+    650,
+    653, 1497,
+    654,
+    663, 1209,
+    666, 1380,
+    671, 1718,
+    674, 745,
+    678, 706,
+    680, 1688,
+    683, 1121, 1225,
+    685, 1175,
+    688, 1594,
+    695, 1341,
+    698, 1290,
+    700, 1565,
+    710,
+    720, 1338,
+    732,
+    739, 1080,
+    741,
+    751, 1192, 1547,
+    752, 1190,
+    754,
+    774, 974,
+    780, 835, 1229,
+    785, 920,
+    792, 851,
+    794,
+    797, 873,
+    798,
+    801,
+    807,
+    820, 1406, 1657,
+    827, 1472,
+    829, 1588,
+    854, 1395,
+    859,
+    865, 958,
+    868, 903, 1631,
+    874,
+    889, 1104,
+    894, 1281,
+    896, 1284,
+    897, 1211,
+    898,
+    913, 1274,
+    916, 1409,
+    928, 1378, 1394, 1609,
+    931, 1674,
+    943,
+    945,
+    952, 1509,
+    960, 1081,
+    961, 1266,
+    967, 1269,
+    972, 1372,
+    973, 1603,
+    975,
+    982, 1689,
+    984,
+    1000, 1408,
+    1005,
+    1020, 1705,
+    1023,
+    1024, 1699,
+    1027, 1649,
+    1029, 1187,
+    1032,
+    1045, 1442,
+    1064, 1711,
+    1065, 1124,
+    1068,
+    1069, 1177,
+    1072,
+    1076,
+    1083, 1125, 1590, 1620,
+    1087, 1132,
+    1089, 1529,
+    1090, 1683,
+    1099, 1102, 1568,
+    1103, 1106, 1404,
+    1105,
+    1107,
+    1110, 1530,
+    1113, 1351, 1717,
+    1122,
+    1126, 1465,
+    1131, 1352,
+    1134, 1431,
+    1149, 1368,
+    1155, 1436,
+    1156,
+    1163,
+    1176, 1231,
+    1180, 1533,
+    1186,
+    1199, 1485,
+    1228, 1574,
+    1247,
+    1252, 1374,
+    1263,
+    1275, 1581,
+    1285,
+    1288, 1376,
+    1291, 1382,
+    1314,
+    1325,
+    1327,
+    1331,
+    1347, 1527,
+    1349,
+    1391, 1577,
+    1393,
+    1417,
+    1418, 1684,
+    1425,
+    1450, 1526,
+    1452, 1481,
+    1455, 1505,
+    1467,
+    1501,
+    1536,
+    1537, 1638,
+    1544,
+    1591,
+    1646, 1673,
+    1696,
+    1698
+};
+
+const tx_t MOS6502_CCC_TRANSISTORS[] = {
+    25, 33, 65, 75, 94, 111, 127, 148, 193, 203, 212, 239, 251, 280, 361, 385, 415, 432, 445, 448, 468, 484, 625, 644, 646, 652, 656, 693, 740, 754, 765, 778, 782, 804, 810, 818, 837, 866, 882, 917, 940, 978, 987,
+    23, 34, 62, 74, 92, 104, 126, 150, 195, 206, 210, 241, 248, 279, 366, 380, 411, 433, 442, 454, 466, 510, 637, 642, 650, 651, 657, 667, 737, 750, 763, 775, 783, 812, 831, 863, 879, 910, 938, 979, 980,
+    155, 222, 894,
+    446,
+    1, 82, 485, 827, 891,
+    18, 27, 61, 68, 88, 108, 131, 145, 190, 201, 209, 227, 240, 252, 284, 360, 386, 410, 430, 441, 453, 467, 486, 518, 521, 561, 586, 636, 649, 742, 747, 759, 774, 780, 815, 830, 867, 876, 911, 935, 974, 983,
+    487,
+    188, 488,
+    489,
+    7, 294, 889,
+    490,
+    491, 872,
+    36, 37, 38, 39, 40, 41, 42, 43, 47, 83, 84, 136, 172, 173, 174, 175, 176, 177, 178, 179, 254, 256, 257, 258, 259, 260, 261, 262, 263, 421, 437, 475, 476, 477, 478, 479, 480, 481, 482, 507, 545, 552, 553, 554, 555, 574, 596, 824, 959, 960, 961, 962, 963, 964, 965, 966,
+    221, 295,
+    314, 461, 492,
+    493,
+    494,
+    114, 121, 123, 231, 296, 769, 826,
+    495,
+    97, 156, 954,
+    496,
+    157, 217, 950,
+    297, 426,
+    497,
+    498,
+    298,
+    10, 100, 499, 840,
+    22, 28, 60, 71, 91, 110, 125, 146, 192, 207, 208, 238, 246, 282, 316, 381, 409, 436, 444, 449, 465, 529, 592, 626, 631, 653, 655, 677, 736, 748, 772, 786, 814, 835, 861, 878, 912, 941, 953, 973, 982,
+    299,
+    19, 29, 63, 69, 89, 106, 132, 151, 196, 204, 214, 242, 249, 281, 290, 302, 379, 384, 412, 435, 438, 450, 471, 500, 513, 638, 641, 645, 670, 687, 739, 753, 764, 776, 784, 813, 832, 865, 880, 915, 934, 975, 984,
+    21, 32, 59, 70, 96, 101, 109, 128, 144, 191, 202, 211, 236, 245, 283, 347, 387, 408, 434, 440, 447, 469, 501, 504, 524, 577, 579, 640, 715, 738, 749, 762, 771, 785, 811, 834, 860, 875, 913, 936, 972, 981,
+    502, 576,
+    86, 135, 517, 821,
+    503,
+    505, 506,
+    300, 395, 819,
+    508, 688,
+    301, 456, 684,
+    509,
+    405, 406,
+    511,
+    512,
+    303,
+    304,
+    20, 31, 64, 72, 90, 105, 130, 147, 194, 200, 213, 237, 250, 286, 333, 382, 414, 429, 443, 452, 470, 527, 544, 556, 558, 635, 643, 648, 743, 751, 760, 777, 779, 796, 817, 833, 862, 881, 914, 937, 977, 986,
+    514,
+    419, 755,
+    305,
+    185, 424,
+    515,
+    306,
+    516,
+    519,
+    315, 457, 520,
+    87, 522,
+    523,
+    57, 232,
+    187,
+    158, 794, 906,
+    4, 968,
+    525,
+    307,
+    526,
+    120, 255, 396, 528, 905,
+    530,
+    531,
+    181, 270,
+    532,
+    533,
+    0, 275, 534, 956,
+    308, 309, 310,
+    535,
+    536,
+    537,
+    329, 458, 538,
+    539,
+    540,
+    228, 276, 633, 732,
+    24, 30, 73, 93, 95, 107, 118, 129, 149, 197, 205, 215, 243, 247, 285, 328, 383, 413, 431, 439, 451, 472, 595, 639, 647, 654, 672, 678, 727, 741, 752, 761, 773, 781, 816, 836, 864, 877, 916, 939, 976, 985,
+    331, 400, 427, 902,
+    418, 541,
+    542,
+    376, 473,
+    543,
+    311,
+    312, 370,
+    313,
+    85, 199, 317, 318, 319, 320, 321,
+    139, 546, 729, 803, 958, 989,
+    547,
+    289, 322, 922,
+    548, 549,
+    550, 793,
+    551,
+    758,
+    11, 45, 159,
+    265, 323, 798, 839, 896, 900,
+    557,
+    559,
+    324,
+    216, 291, 560, 841,
+    325, 417,
+    562,
+    563, 946,
+    564,
+    326, 459, 717,
+    266, 744,
+    122, 327, 402, 920, 947,
+    113, 756,
+    565,
+    566,
+    567,
+    5, 244, 365,
+    788,
+    568,
+    160, 903, 991,
+    569,
+    570,
+    918, 942, 944,
+    571,
+    572,
+    573,
+    575,
+    180, 277, 628, 733, 932,
+    273, 578,
+    422, 580, 766, 842,
+    581,
+    142, 219,
+    582,
+    58, 67,
+    278,
+    6, 17, 330,
+    229, 583, 843, 929,
+    584,
+    585,
+    332,
+    587,
+    588,
+    589,
+    388, 590,
+    161, 223, 895,
+    8, 292, 334,
+    591,
+    56, 119, 464,
+    377, 593, 873, 890,
+    594,
+    597,
+    598,
+    599,
+    600,
+    601,
+    153, 928,
+    253, 353, 403, 790, 943,
+    602,
+    603, 858,
+    98, 162, 955,
+    604,
+    605, 886,
+    335,
+    606,
+    336,
+    423, 607, 768, 844,
+    608, 679,
+    198, 220,
+    369, 460, 609,
+    293, 610, 828, 845,
+    154, 184, 189, 703,
+    623,
+    624,
+    338,
+    102, 339, 401, 807, 948,
+    627, 952,
+    340,
+    341,
+    112, 416, 629, 757, 871, 898, 945,
+    404, 673, 746, 791, 901,
+    50, 455, 630, 885,
+    163, 904, 992,
+    632,
+    76,
+    342, 820, 868,
+    634,
+    164, 218, 951,
+    26, 274,
+    343,
+    13, 48, 611, 846,
+    658, 823,
+    344,
+    345,
+    659,
+    660,
+    661,
+    662, 709,
+    663,
+    664,
+    665,
+    346, 800,
+    666,
+    797, 893,
+    348,
+    805,
+    420, 770,
+    115, 269, 612, 847,
+    268, 389, 668, 919,
+    669,
+    967,
+    671,
+    141, 474, 674, 988,
+    349,
+    140, 350, 870,
+    134, 165, 390,
+    351,
+    133, 166, 391,
+    80, 613, 734, 848,
+    152,
+    51, 234, 675, 883,
+    352,
+    676,
+    354, 735,
+    99, 614, 825, 849,
+    680,
+    81, 681, 809, 859,
+    2, 124, 615, 850,
+    682,
+    683,
+    685,
+    686,
+    616, 851, 869, 925,
+    355,
+    356, 924,
+    357, 462, 723,
+    358,
+    802, 909,
+    14, 233,
+    689,
+    690,
+    359,
+    691,
+    143, 183, 949, 969,
+    692,
+    428,
+    694,
+    226, 617, 730, 852,
+    264, 767, 908,
+    787, 874,
+    695,
+    970,
+    696,
+    697,
+    698,
+    137,
+    699,
+    700,
+    701,
+    397, 618, 853, 927,
+    702,
+    53, 167, 399,
+    168, 795, 907,
+    362, 463, 710,
+    363,
+    364,
+    704,
+    705, 806, 887, 930,
+    49, 52, 103, 116, 706, 838, 931, 957,
+    892, 990,
+    35, 230, 822, 899, 926,
+    707,
+    44, 117, 182, 708, 808, 829, 923, 933,
+    483,
+    711,
+    712,
+    713,
+    367,
+    714,
+    55, 971,
+    393, 897,
+    716,
+    368,
+    271, 287, 619, 854,
+    718,
+    719,
+    16, 337,
+    720,
+    66, 267, 620, 855,
+    371,
+    77,
+    372,
+    373,
+    792,
+    54, 169, 398,
+    394,
+    235, 407, 621, 856,
+    721,
+    138, 921,
+    722,
+    78, 789,
+    288, 392,
+    374,
+    745, 888,
+    375,
+    724,
+    725,
+    171, 801,
+    12, 46, 170,
+    9, 378, 731,
+    726,
+    799,
+    3, 224,
+    728,
+    186, 425,
+    272, 622, 857, 884
+};
+
 #endif /* INCLUDE_MOS6502_LAYOUT_H */
@@ -1,6 +1,7 @@
 #include "memory.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 mos6502_memory_t * mos6502_memory_init(void) {
     return (mos6502_memory_t *)calloc(1, sizeof(mos6502_memory_t));
@@ -17,3 +18,44 @@ mos6502_word_t mos6502_memory_read(const mos6502_memory_t * memory, mos6502_addr
 void mos6502_memory_write(mos6502_memory_t * memory, mos6502_addr_t addr, mos6502_word_t word) {
     memory->memory[addr >> 0] = word;
 }
+
+void mos6502_memory_read_block(const mos6502_memory_t * memory, mos6502_addr_t addr,
+                               unsigned char * data, size_t count) {
+    size_t head;
+
+    /* Copy up to the end of the address space, then wrap around */
+    while (count > 0) {
+        head = MOS6502_MEMORY_WORD_COUNT - (addr >> 0);
+        head = count < head ? count : head;
+
+        memcpy(data, &memory->memory[addr >> 0], head);
+
+        addr = 0;
+        data += head;
+        count -= head;
+    }
+}
+
+void mos6502_memory_write_block(mos6502_memory_t * memory, mos6502_addr_t addr,
+                                const unsigned char * data, size_t count) {
+    size_t head;
+
+    /* Copy up to the end of the address space, then wrap around */
+    while (count > 0) {
+        head = MOS6502_MEMORY_WORD_COUNT - (addr >> 0);
+        head = count < head ? count : head;
+
+        memcpy(&memory->memory[addr >> 0], data, head);
+
+        addr = 0;
+        data += head;
+        count -= head;
+    }
+}
+
+const unsigned char * mos6502_memory_data(const mos6502_memory_t * memory, mos6502_addr_t addr,
+                                          size_t * count) {
+    *count = MOS6502_MEMORY_WORD_COUNT - (addr >> 0);
+
+    return &memory->memory[addr >> 0];
+}
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_MOS6502_MEMORY_H
 #define INCLUDE_MOS6502_MEMORY_H
 
+#include <stddef.h>
+
 /* --- Constants --- */
 
 enum { MOS6502_MEMORY_ADDR_WIDTH = 16 };
@@ -22,5 +24,11 @@ mos6502_memory_t * mos6502_memory_init(void);
 void mos6502_memory_destroy(mos6502_memory_t * memory);
 mos6502_word_t mos6502_memory_read(const mos6502_memory_t * memory, mos6502_addr_t addr);
 void mos6502_memory_write(mos6502_memory_t * memory, mos6502_addr_t addr, mos6502_word_t word);
+void mos6502_memory_read_block(const mos6502_memory_t * memory, mos6502_addr_t addr,
+                               unsigned char * data, size_t count);
+void mos6502_memory_write_block(mos6502_memory_t * memory, mos6502_addr_t addr,
+                                const unsigned char * data, size_t count);
+const unsigned char * mos6502_memory_data(const mos6502_memory_t * memory, mos6502_addr_t addr,
+                                          size_t * count);
 
 #endif /* INCLUDE_MOS6502_MEMORY_H */
@@ -24,7 +24,35 @@ mos6502_t * mos6502_init(void) {
         MOS6502_FUNCTION_DEFS,
         MOS6502_FUNCTION_COUNT,
         MOS6502_CELL_DEFS,
-        MOS6502_CELL_COUNT
+        MOS6502_CELL_COUNT,
+        NULL,
+        MOS6502_WORD_COUNT,
+        NULL,
+        MOS6502_PLA_COUNT,
+        NULL,
+        MOS6502_PLA_TERM_COUNT,
+        NULL,
+        MOS6502_CHAIN_COUNT,
+        NULL,
+        MOS6502_CHAIN_STAGE_COUNT,
+        NULL,
+        MOS6502_PASS_COUNT,
+        NULL,
+        MOS6502_BUS_COUNT,
+        NULL,
+        MOS6502_CLOCK_COUNT,
+        NULL,
+        MOS6502_CLOCK_OUTPUT_COUNT,
+        NULL,
+        MOS6502_CLOCK_STEP_COUNT,
+        NULL,
+        MOS6502_CLOCK_CHANGE_COUNT,
+        MOS6502_CCC_DEFS,
+        MOS6502_CCC_COUNT,
+        MOS6502_CCC_NODES,
+        MOS6502_CCC_NODE_COUNT,
+        MOS6502_CCC_TRANSISTORS,
+        MOS6502_CCC_TRANSISTOR_COUNT
     };
 
     /* Initialize new IC emulator */
@@ -115,6 +115,15 @@ static value_t adapter_instance_read_pin(const void * instance, const char * pin
 static void adapter_instance_write_pin(void * instance, const char * pin, unsigned int data);
 static value_t adapter_instance_read_mem(const void * instance, unsigned int addr);
 static void adapter_instance_write_mem(void * instance, unsigned int addr, unsigned int data);
+static void adapter_instance_read_mem_block(const void * instance, unsigned int addr,
+                                            unsigned char * data, size_t count);
+static void adapter_instance_write_mem_block(void * instance, unsigned int addr,
+                                             const unsigned char * data, size_t count);
+static const unsigned char * adapter_instance_get_mem(const void * instance, unsigned int addr,
+                                                      size_t * count);
+static int adapter_instance_resolve_pin(const void * instance, const char * pin);
+static value_t adapter_instance_read_pin_handle(const void * instance, int pin);
+static void adapter_instance_write_pin_handle(void * instance, int pin, unsigned int data);
 
 /* --- Adapter singleton --- */
 
@@ -134,6 +143,12 @@ static const adapter_t PERFECT6502_ADAPTER = {
     adapter_instance_write_pin,
     adapter_instance_read_mem,
     adapter_instance_write_mem,
+    adapter_instance_read_mem_block,
+    adapter_instance_write_mem_block,
+    adapter_instance_get_mem,
+    adapter_instance_resolve_pin,
+    adapter_instance_read_pin_handle,
+    adapter_instance_write_pin_handle,
 };
 
 /* --- Public functions --- */
@@ -373,6 +388,139 @@ void adapter_instance_write_pin(void * instance, const char * pin, unsigned int
     }
 }
 
+int adapter_instance_resolve_pin(const void * instance, const char * pin) {
+    size_t offset = 0;
+    size_t i;
+
+    for (i = 0; i < PERFECT6502_PIN_16_HEX_COUNT; i++) {
+        if (strcmp(pin, PERFECT6502_PIN_16_HEX_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    offset += PERFECT6502_PIN_16_HEX_COUNT;
+
+    for (i = 0; i < PERFECT6502_PIN_8_HEX_COUNT; i++) {
+        if (strcmp(pin, PERFECT6502_PIN_8_HEX_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    offset += PERFECT6502_PIN_8_HEX_COUNT;
+
+    for (i = 0; i < PERFECT6502_PIN_8_BIN_COUNT; i++) {
+        if (strcmp(pin, PERFECT6502_PIN_8_BIN_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    offset += PERFECT6502_PIN_8_BIN_COUNT;
+
+    for (i = 0; i < PERFECT6502_PIN_1_COUNT; i++) {
+        if (strcmp(pin, PERFECT6502_PIN_1_MAP[i].pin) == 0) {
+            return (int)(offset + i);
+        }
+    }
+
+    return -1;
+}
+
+value_t adapter_instance_read_pin_handle(const void * instance, int pin) {
+    const perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
+    size_t i = (size_t)pin;
+
+    if (pin < 0) {
+        return (value_t){ 0, 0, 0 };
+    }
+
+    if (i < PERFECT6502_PIN_16_HEX_COUNT) {
+        if (PERFECT6502_PIN_16_HEX_MAP[i].read_func == NULL) {
+            return (value_t){ 0, 0, 0 };
+        }
+
+        return (value_t){ PERFECT6502_PIN_16_HEX_MAP[i].read_func(perfect6502_instance->perfect6502), 16, 16 };
+    }
+
+    i -= PERFECT6502_PIN_16_HEX_COUNT;
+
+    if (i < PERFECT6502_PIN_8_HEX_COUNT) {
+        if (PERFECT6502_PIN_8_HEX_MAP[i].read_func == NULL) {
+            return (value_t){ 0, 0, 0 };
+        }
+
+        return (value_t){ PERFECT6502_PIN_8_HEX_MAP[i].read_func(perfect6502_instance->perfect6502), 8, 16 };
+    }
+
+    i -= PERFECT6502_PIN_8_HEX_COUNT;
+
+    if (i < PERFECT6502_PIN_8_BIN_COUNT) {
+        if (PERFECT6502_PIN_8_BIN_MAP[i].read_func == NULL) {
+            return (value_t){ 0, 0, 0 };
+        }
+
+        return (value_t){ PERFECT6502_PIN_8_BIN_MAP[i].read_func(perfect6502_instance->perfect6502), 8, 2 };
+    }
+
+    i -= PERFECT6502_PIN_8_BIN_COUNT;
+
+    if (i < PERFECT6502_PIN_1_COUNT) {
+        if (PERFECT6502_PIN_1_MAP[i].read_func == NULL) {
+            return (value_t){ 0, 0, 0 };
+        }
+
+        return (value_t){ PERFECT6502_PIN_1_MAP[i].read_func(perfect6502_instance->perfect6502), 1, 10 };
+    }
+
+    return (value_t){ 0, 0, 0 };
+}
+
+void adapter_instance_write_pin_handle(void * instance, int pin, unsigned int data) {
+    perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
+    size_t i = (size_t)pin;
+
+    if (pin < 0) {
+        return;
+    }
+
+    if (i < PERFECT6502_PIN_16_HEX_COUNT) {
+        if (PERFECT6502_PIN_16_HEX_MAP[i].write_func != NULL) {
+            PERFECT6502_PIN_16_HEX_MAP[i].write_func(perfect6502_instance->perfect6502, data);
+        }
+
+        return;
+    }
+
+    i -= PERFECT6502_PIN_16_HEX_COUNT;
+
+    if (i < PERFECT6502_PIN_8_HEX_COUNT) {
+        if (PERFECT6502_PIN_8_HEX_MAP[i].write_func != NULL) {
+            PERFECT6502_PIN_8_HEX_MAP[i].write_func(perfect6502_instance->perfect6502, data);
+        }
+
+        return;
+    }
+
+    i -= PERFECT6502_PIN_8_HEX_COUNT;
+
+    if (i < PERFECT6502_PIN_8_BIN_COUNT) {
+        if (PERFECT6502_PIN_8_BIN_MAP[i].write_func != NULL) {
+            PERFECT6502_PIN_8_BIN_MAP[i].write_func(perfect6502_instance->perfect6502, data);
+        }
+
+        return;
+    }
+
+    i -= PERFECT6502_PIN_8_BIN_COUNT;
+
+    if (i < PERFECT6502_PIN_1_COUNT) {
+        if (PERFECT6502_PIN_1_MAP[i].write_func != NULL) {
+            PERFECT6502_PIN_1_MAP[i].write_func(perfect6502_instance->perfect6502, data);
+        }
+
+        return;
+    }
+}
+
 value_t adapter_instance_read_mem(const void * instance, unsigned int addr) {
     const perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
 
@@ -391,6 +539,39 @@ void adapter_instance_write_mem(void * instance, unsigned int addr, unsigned int
     perfect6502_memory_write(perfect6502_instance->memory, addr, data);
 }
 
+void adapter_instance_read_mem_block(const void * instance, unsigned int addr,
+                                     unsigned char * data, size_t count) {
+    const perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        data[i] = perfect6502_memory_read(perfect6502_instance->memory, addr + i);
+    }
+}
+
+void adapter_instance_write_mem_block(void * instance, unsigned int addr,
+                                      const unsigned char * data, size_t count) {
+    perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        perfect6502_memory_write(perfect6502_instance->memory, addr + i, data[i]);
+    }
+}
+
+const unsigned char * adapter_instance_get_mem(const void * instance, unsigned int addr,
+                                               size_t * count) {
+    const perfect6502_instance_t * perfect6502_instance = (perfect6502_instance_t *)instance;
+
+    if (addr >= PERFECT6502_MEMORY_ADDR_SPACE) {
+        return NULL;
+    }
+
+    *count = PERFECT6502_MEMORY_ADDR_SPACE - addr;
+
+    return &perfect6502_instance->memory->memory[addr];
+}
+
 /* --- Wrapper functions --- */
 
 BOOL perfect6502_get_clk(state_t * perfect6502) {
@@ -17,9 +17,16 @@
 enum {
     BUF_LEN  = 4096,
     PIN_LEN  = 16,
-    MAX_PINS = 64
+    MAX_PINS = 64,
+    VAR_LEN  = 16,
+    MAX_BLOCKS = 16
 };
 
+enum { CACHE_VERSION = 2 };
+
+static const char CACHE_MAGIC[4] = { 'I', 'C', 'E', 'C' };
+static const char CACHE_SUFFIX[] = "c";
+
 /* --- Types --- */
 
 typedef enum {
@@ -52,9 +59,43 @@ typedef enum {
     STATE_MEMSET_DATA,
     STATE_MEMTEST_ADDR,
     STATE_MEMTEST_DATA,
-    STATE_RUN_CYCLES
+    STATE_MEMLOAD_FILE,
+    STATE_MEMLOAD_ADDR,
+    STATE_MEMDUMP_FILE,
+    STATE_MEMDUMP_ADDR,
+    STATE_MEMDUMP_COUNT,
+    STATE_MEMCMP_FILE,
+    STATE_MEMCMP_ADDR,
+    STATE_RUN_CYCLES,
+    STATE_REPEAT_COUNT,
+    STATE_REPEAT_VAR,
+    STATE_SET_VAR,
+    STATE_SET_VALUE
 } state_t;
 
+typedef enum {
+    OP_NOP,
+    OP_START,
+    OP_EXIT,
+    OP_DEVICE,
+    OP_EXEC,
+    OP_INFO,
+    OP_PINS,
+    OP_PINDEF,
+    OP_PINTEST,
+    OP_MEMSET,
+    OP_MEMTEST,
+    OP_MEMLOAD,
+    OP_MEMDUMP,
+    OP_MEMCMP,
+    OP_RESET,
+    OP_STEP,
+    OP_RUN,
+    OP_REPEAT,
+    OP_END,
+    OP_SET
+} op_t;
+
 typedef struct {
     unsigned int data;
     unsigned int mask;
@@ -62,6 +103,63 @@ typedef struct {
     size_t base;
 } test_t;
 
+typedef struct {
+    test_t test;    /* Pre-parsed word, value or test */
+    size_t var;     /* Variable added to the test data at run time (1-based), or 0 */
+    size_t str;     /* Offset of a string operand (pin name) in the string pool */
+} arg_t;
+
+typedef struct {
+    op_t op;
+    size_t line;
+    unsigned int addr;
+    size_t addr_var;    /* Variable added to addr at run time (1-based), or 0 */
+    size_t count;
+    size_t count_var;   /* Variable added to count at run time (1-based), or 0 */
+    size_t var;         /* Variable written by the instruction (1-based), or 0 */
+    size_t jump;        /* Index of the matching .repeat or .end instruction */
+    size_t str;         /* Offset of a string operand (file name, text) in the string pool */
+    size_t args;        /* Offset of the first operand in the operand pool */
+    size_t args_count;
+} instr_t;
+
+typedef struct {
+    instr_t * instrs;
+    size_t instrs_count;
+    size_t instrs_size;
+
+    arg_t * args;
+    size_t args_count;
+    size_t args_size;
+
+    char * strs;
+    size_t strs_len;
+    size_t strs_size;
+
+    /* Variable names are only needed while compiling, values persist between executions */
+    char * vars;
+    unsigned int * vals;
+    size_t vars_count;
+    size_t vars_size;
+
+    /* Open .repeat blocks while compiling */
+    size_t blocks[MAX_BLOCKS];
+    size_t blocks_count;
+} prog_t;
+
+typedef struct {
+    char magic[4];
+    unsigned long version;
+    unsigned long instr_size;
+    unsigned long arg_size;
+    unsigned long source_hash;
+    long source_size;
+    unsigned long instrs_count;
+    unsigned long args_count;
+    unsigned long strs_len;
+    unsigned long vars_count;
+} cache_header_t;
+
 typedef struct {
     void * dl;
     const adapter_t * adapter;
@@ -71,28 +169,32 @@ typedef struct {
 typedef struct {
     const char * file;
     size_t line;
+    size_t pc;
     rc_t success;
+    int cache;
+
+    prog_t * prog;
 
     device_t * device;
 
     char ** pins;
     char * pins_buf;
+    int * pin_handles;
     size_t pins_count;
-
-    test_t * pin_tests;
-    size_t pin_tests_count;
-
-    unsigned int mem_addr;
-    size_t mem_offset;
 } env_t;
 
-static state_t runtime_exec_repl(void);
-static state_t runtime_exec_file(const char * file);
-static state_t runtime_exec_stream(env_t * env, FILE * stream);
-static state_t runtime_exec_line(env_t * env, char * buf, state_t state);
-static state_t runtime_exec_flush(env_t * env, state_t state);
-static state_t runtime_exec_eof(env_t * env, state_t state);
-static state_t runtime_exec_token(env_t * env, const char * tok, const char * buf, state_t state);
+static state_t runtime_exec_repl(int cache);
+static state_t runtime_exec_file(const char * file, int cache);
+static state_t runtime_exec_prog(env_t * env, prog_t * prog);
+static state_t runtime_exec_instr(env_t * env, prog_t * prog, const instr_t * instr);
+
+static prog_t * runtime_load(env_t * env, const char * file);
+static state_t runtime_compile_stream(env_t * env, FILE * stream);
+static state_t runtime_compile_line(env_t * env, char * buf, state_t state);
+static state_t runtime_compile_flush(env_t * env, state_t state);
+static state_t runtime_compile_eof(env_t * env, state_t state);
+static state_t runtime_compile_token(env_t * env, const char * tok, const char * buf,
+                                     state_t state);
 
 static state_t runtime_handle_start(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_cmd(env_t * env, const char * tok, const char * buf);
@@ -118,14 +220,69 @@ static state_t runtime_handle_memtest(env_t * env, const char * tok, const char
 static state_t runtime_handle_memtest_addr(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_memtest_data(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_memtest_end(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memload(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memload_file(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memload_addr(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memdump(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memdump_file(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memdump_addr(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memdump_count(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memcmp(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memcmp_file(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_memcmp_addr(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_reset(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_step(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_run(env_t * env, const char * tok, const char * buf);
 static state_t runtime_handle_run_cycles(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_repeat(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_repeat_count(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_repeat_var(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_end(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_set(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_set_var(env_t * env, const char * tok, const char * buf);
+static state_t runtime_handle_set_value(env_t * env, const char * tok, const char * buf);
+
+static state_t runtime_op_start(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_exit(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_device(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_exec(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_info(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_pins(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_pindef(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_pintest(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_memset(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_memtest(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_memload(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_memdump(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_memcmp(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_reset(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_step(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_run(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_repeat(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_end(env_t * env, prog_t * prog, const instr_t * instr);
+static state_t runtime_op_set(env_t * env, prog_t * prog, const instr_t * instr);
+
+static unsigned int runtime_eval(const prog_t * prog, unsigned int data, size_t var);
+static test_t runtime_eval_arg(const prog_t * prog, const arg_t * arg);
 
 static rc_t runtime_test(env_t * env, value_t val, test_t test);
 
-static rc_t runtime_parse_value(const env_t * env, const char * tok, value_t * val);
+static value_t runtime_read_pin(const env_t * env, size_t p);
+
+static rc_t runtime_read_image(const env_t * env, const char * file,
+                               unsigned char ** data, size_t * count);
+static const unsigned char * runtime_read_mem_block(const env_t * env, unsigned int addr,
+                                                    unsigned char * data, size_t count);
+static void runtime_write_mem_block(const env_t * env, unsigned int addr,
+                                    const unsigned char * data, size_t count);
+
+static rc_t runtime_memload_bin(const env_t * env, const char * file, unsigned int addr,
+                                size_t * count);
+static rc_t runtime_memload_hex(const env_t * env, const char * file, unsigned int addr,
+                                size_t * count);
+
+static rc_t runtime_parse_operand(env_t * env, const char * tok, test_t * test, size_t * var);
+static rc_t runtime_parse_var(const env_t * env, const char * tok);
 static rc_t runtime_parse_test(const env_t * env, const char * tok, test_t * test);
 static rc_t runtime_parse_test_hex(const env_t * env, const char * tok, test_t * test);
 static rc_t runtime_parse_test_bin(const env_t * env, const char * tok, test_t * test);
@@ -144,22 +301,47 @@ static void runtime_print_test_hex(const env_t * env, style_t style, test_t test
 static void runtime_print_test_bin(const env_t * env, style_t style, test_t test);
 static void runtime_print_test_dec(const env_t * env, style_t style, test_t test);
 
+static prog_t * runtime_prog_init(void);
+static void runtime_prog_destroy(prog_t * prog);
+static void runtime_prog_reset(prog_t * prog);
+static instr_t * runtime_prog_begin(env_t * env, op_t op);
+static instr_t * runtime_prog_instr(env_t * env);
+static void runtime_prog_commit(env_t * env);
+static arg_t * runtime_prog_arg(env_t * env);
+static size_t runtime_prog_str(env_t * env, const char * str);
+static size_t runtime_prog_var(env_t * env, const char * name, int define);
+
+static prog_t * runtime_cache_read(const char * file);
+static void runtime_cache_write(const char * file, const prog_t * prog);
+static rc_t runtime_cache_stamp(const char * file, cache_header_t * header);
+
 static device_t * runtime_device_init(const char * file, const char * id);
 static void runtime_device_destroy(device_t * device);
 
-static env_t * runtime_env_init(const char * file);
+static env_t * runtime_env_init(const char * file, int cache);
 static void runtime_env_destroy(env_t * env);
 
 /* --- Main --- */
 
 int main (int argc, char * argv[]) {
     int i;
+    int cache = 0;
     state_t state = STATE_NONE;
 
+    /* Parse options */
+    for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+        if (strcmp(argv[i], "-c") == 0) {
+            cache = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [-c] [file ...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
     /* Execute files sequentially if specified, otherwise open the REPL */
-    if (argc > 1) {
-        for (i = 1; i < argc; i++) {
-            state = runtime_exec_file(argv[i]);
+    if (i < argc) {
+        for (; i < argc; i++) {
+            state = runtime_exec_file(argv[i], cache);
 
             /* Stop execution on error or failure */
             if (state == STATE_FAILURE || state == STATE_ERR) {
@@ -167,7 +349,7 @@ int main (int argc, char * argv[]) {
             }
         }
     } else {
-        state = runtime_exec_repl();
+        state = runtime_exec_repl(cache);
     }
 
     if (state == STATE_SUCCESS) {
@@ -179,22 +361,21 @@ int main (int argc, char * argv[]) {
 
 /* --- Private functions --- */
 
-state_t runtime_exec_repl(void) {
+state_t runtime_exec_repl(int cache) {
 
     /* Initialize environment */
-    env_t * env = runtime_env_init("shell");
+    env_t * env = runtime_env_init("shell", cache);
+    prog_t * prog = runtime_prog_init();
 
-    /* Parse and execute line by line */
+    /* Compile and execute line by line */
     char buf[BUF_LEN] = "";
     state_t state = STATE_START;
+    state_t result = STATE_NONE;
 
-    do {
-        state = runtime_exec_line(env, buf, state);
+    env->prog = prog;
 
-        /* Stop execution only on exit */
-        if (state == STATE_SUCCESS || state == STATE_FAILURE) {
-            break;
-        }
+    do {
+        state = runtime_compile_line(env, buf, state);
 
         /* On error, read the next command */
         if (state == STATE_ERR) {
@@ -202,76 +383,247 @@ state_t runtime_exec_repl(void) {
         }
 
         /* Flush unterminated commands on EOL */
-        state = runtime_exec_flush(env, state);
+        if (state != STATE_SUCCESS && state != STATE_FAILURE) {
+            state = runtime_compile_flush(env, state);
+        }
+
+        /* Execute the commands completed on this line, unless a block is still open */
+        if (prog->blocks_count == 0) {
+            result = runtime_exec_prog(env, prog);
+            runtime_prog_reset(prog);
+        }
+
+        /* Stop execution only on exit */
+        if (result == STATE_SUCCESS || result == STATE_FAILURE) {
+            break;
+        }
+
+        /* An exit that was not reached due to an error leaves the shell open */
+        if (state == STATE_SUCCESS || state == STATE_FAILURE) {
+            state = STATE_CMD;
+        }
 
         /* Print a command prompt */
         runtime_print(env, STYLE_INFO, "> ");
+
+        /* Increment line counter */
+        env->line++;
     } while (fgets(buf, BUF_LEN, stdin) != NULL);
 
     /* Finish execution on EOF */
     if (feof(stdin)) {
-        state = runtime_exec_eof(env, state);
+        runtime_compile_eof(env, state);
+
+        result = runtime_exec_prog(env, prog);
     }
 
     if (ferror(stdin)) {
         runtime_error(env, "%s", strerror(errno));
-        state = STATE_ERR;
+        result = STATE_ERR;
     }
 
     /* Clean up environment */
+    runtime_prog_destroy(prog);
     runtime_env_destroy(env);
 
-    return state;
+    return result;
 }
 
-state_t runtime_exec_file(const char * file) {
+state_t runtime_exec_file(const char * file, int cache) {
     env_t * env;
+    prog_t * prog;
     state_t state = STATE_NONE;
 
-    /* Open file for reading */
-    FILE * f = fopen(file, "r");
+    /* Initialize runtime environment */
+    env = runtime_env_init(file, cache);
 
-    if (f == NULL) {
-        fprintf(stderr, "Error opening '%s': %s\n", file, strerror(errno));
+    /* Compile file, or load it from the cache */
+    prog = runtime_load(env, file);
+
+    if (prog == NULL) {
+        runtime_env_destroy(env);
         return STATE_ERR;
     }
 
-    /* Initialize runtime environment */
-    env = runtime_env_init(file);
-
-    /* Execute contents of file */
-    state = runtime_exec_stream(env, f);
+    /* Execute program */
+    state = runtime_exec_prog(env, prog);
 
     /* Clean up environment */
+    runtime_prog_destroy(prog);
     runtime_env_destroy(env);
 
-    /* Close stream */
-    fclose(f);
-
     return state;
 }
 
-state_t runtime_exec_stream(env_t * env, FILE * stream) {
+state_t runtime_exec_prog(env_t * env, prog_t * prog) {
+    state_t state = STATE_CMD;
 
-    /* Parse and execute line by line */
-    char buf[BUF_LEN] = "";
-    state_t state = STATE_START;
+    env->pc = 0;
 
-    do {
-        state = runtime_exec_line(env, buf, state);
+    while (env->pc < prog->instrs_count) {
+        const instr_t * instr = &prog->instrs[env->pc];
+
+        /* Report errors against the source line of the instruction */
+        env->line = instr->line;
+
+        /* Advance to the next instruction unless the instruction jumps */
+        env->pc++;
+
+        state = runtime_exec_instr(env, prog, instr);
 
         /* Stop execution on exit or on error */
         if (state == STATE_SUCCESS || state == STATE_FAILURE || state == STATE_ERR) {
             break;
         }
+    }
+
+    return state;
+}
+
+state_t runtime_exec_instr(env_t * env, prog_t * prog, const instr_t * instr) {
+
+    /* Validate device for commands that operate on it */
+    switch (instr->op) {
+        case OP_NOP:
+        case OP_START:
+        case OP_EXIT:
+        case OP_DEVICE:
+        case OP_EXEC:
+        case OP_INFO:
+        case OP_REPEAT:
+        case OP_END:
+        case OP_SET:
+            break;
+        default:
+            if (env->device == NULL) {
+                runtime_error(env, "No device configured");
+                return STATE_ERR;
+            }
+    }
+
+    /* Dispatch instruction */
+    switch (instr->op) {
+        case OP_NOP:
+            return STATE_CMD;
+        case OP_START:
+            return runtime_op_start(env, prog, instr);
+        case OP_EXIT:
+            return runtime_op_exit(env, prog, instr);
+        case OP_DEVICE:
+            return runtime_op_device(env, prog, instr);
+        case OP_EXEC:
+            return runtime_op_exec(env, prog, instr);
+        case OP_INFO:
+            return runtime_op_info(env, prog, instr);
+        case OP_PINS:
+            return runtime_op_pins(env, prog, instr);
+        case OP_PINDEF:
+            return runtime_op_pindef(env, prog, instr);
+        case OP_PINTEST:
+            return runtime_op_pintest(env, prog, instr);
+        case OP_MEMSET:
+            return runtime_op_memset(env, prog, instr);
+        case OP_MEMTEST:
+            return runtime_op_memtest(env, prog, instr);
+        case OP_MEMLOAD:
+            return runtime_op_memload(env, prog, instr);
+        case OP_MEMDUMP:
+            return runtime_op_memdump(env, prog, instr);
+        case OP_MEMCMP:
+            return runtime_op_memcmp(env, prog, instr);
+        case OP_RESET:
+            return runtime_op_reset(env, prog, instr);
+        case OP_STEP:
+            return runtime_op_step(env, prog, instr);
+        case OP_RUN:
+            return runtime_op_run(env, prog, instr);
+        case OP_REPEAT:
+            return runtime_op_repeat(env, prog, instr);
+        case OP_END:
+            return runtime_op_end(env, prog, instr);
+        case OP_SET:
+            return runtime_op_set(env, prog, instr);
+        default:
+            runtime_error(env, "Unexpected instruction %d", instr->op);
+            return STATE_ERR;
+    }
+}
+
+prog_t * runtime_load(env_t * env, const char * file) {
+    prog_t * prog;
+    prog_t * old_prog;
+    const char * old_file;
+    size_t old_line;
+    state_t state;
+    FILE * f;
+
+    /* Reuse a cached compilation if it is still current */
+    if (env->cache && (prog = runtime_cache_read(file)) != NULL) {
+        return prog;
+    }
+
+    /* Open file for reading */
+    f = fopen(file, "r");
+
+    if (f == NULL) {
+        runtime_error(env, "Error opening file '%s': %s", file, strerror(errno));
+        return NULL;
+    }
+
+    /* Compile contents of file into a new program */
+    prog = runtime_prog_init();
+
+    old_prog = env->prog;
+    old_file = env->file;
+    old_line = env->line;
+
+    env->prog = prog;
+    env->file = file;
+
+    state = runtime_compile_stream(env, f);
+
+    env->prog = old_prog;
+    env->file = old_file;
+    env->line = old_line;
+
+    fclose(f);
+
+    if (state == STATE_ERR) {
+        runtime_prog_destroy(prog);
+        return NULL;
+    }
+
+    if (env->cache) {
+        runtime_cache_write(file, prog);
+    }
+
+    return prog;
+}
+
+state_t runtime_compile_stream(env_t * env, FILE * stream) {
+
+    /* Parse and compile line by line */
+    char buf[BUF_LEN] = "";
+    state_t state = STATE_START;
+
+    env->line = 0;
+
+    while (fgets(buf, BUF_LEN, stream) != NULL) {
 
         /* Increment line counter */
         env->line++;
-    } while (fgets(buf, BUF_LEN, stream) != NULL);
 
-    /* Finish execution on EOF */
+        state = runtime_compile_line(env, buf, state);
+
+        /* Stop compilation on exit or on error */
+        if (state == STATE_SUCCESS || state == STATE_FAILURE || state == STATE_ERR) {
+            break;
+        }
+    }
+
+    /* Finish compilation on EOF */
     if (feof(stream)) {
-        state = runtime_exec_eof(env, state);
+        state = runtime_compile_eof(env, state);
     }
 
     if (ferror(stream)) {
@@ -282,7 +634,7 @@ state_t runtime_exec_stream(env_t * env, FILE * stream) {
     return state;
 }
 
-state_t runtime_exec_line(env_t * env, char * buf, state_t state) {
+state_t runtime_compile_line(env_t * env, char * buf, state_t state) {
     char * ptr;
     char * tok;
     char * end;
@@ -309,7 +661,7 @@ state_t runtime_exec_line(env_t * env, char * buf, state_t state) {
         }
 
         /* Handle state */
-        state = runtime_exec_token(env, tok, buf, state);
+        state = runtime_compile_token(env, tok, buf, state);
 
         /* Resume parsing on the next line on NEXT */
         if (state == STATE_NEXT) {
@@ -328,24 +680,36 @@ state_t runtime_exec_line(env_t * env, char * buf, state_t state) {
     return state;
 }
 
-state_t runtime_exec_flush(env_t * env, state_t state) {
+state_t runtime_compile_flush(env_t * env, state_t state) {
 
-    /* Execute a .nop to finish any unterminated commands */
-    return runtime_exec_token(env, ".nop", "", state);
+    /* Compile a .nop to finish any unterminated commands */
+    return runtime_compile_token(env, ".nop", "", state);
 }
 
-state_t runtime_exec_eof(env_t * env, state_t state) {
+state_t runtime_compile_eof(env_t * env, state_t state) {
 
     /* If already in an exit state, nothing more to do */
     if (state == STATE_SUCCESS || state == STATE_FAILURE) {
         return state;
     }
 
-    /* Execute an implicit .exit to finish unterminated commands and run exit sequence */
-    return runtime_exec_token(env, ".exit", "", state);
+    /* Finish unterminated commands before checking for open blocks */
+    state = runtime_compile_flush(env, state);
+
+    if (state == STATE_ERR) {
+        return state;
+    }
+
+    if (env->prog->blocks_count > 0) {
+        runtime_error(env, "Unterminated .repeat block");
+        return STATE_ERR;
+    }
+
+    /* Compile an implicit .exit to finish unterminated commands and run exit sequence */
+    return runtime_compile_token(env, ".exit", "", state);
 }
 
-state_t runtime_exec_token(env_t * env, const char * tok, const char * buf, state_t state) {
+state_t runtime_compile_token(env_t * env, const char * tok, const char * buf, state_t state) {
 
     /* Handle token based on state */
     switch (state) {
@@ -369,8 +733,30 @@ state_t runtime_exec_token(env_t * env, const char * tok, const char * buf, stat
             return runtime_handle_memtest_addr(env, tok, buf);
         case STATE_MEMTEST_DATA:
             return runtime_handle_memtest_data(env, tok, buf);
+        case STATE_MEMLOAD_FILE:
+            return runtime_handle_memload_file(env, tok, buf);
+        case STATE_MEMLOAD_ADDR:
+            return runtime_handle_memload_addr(env, tok, buf);
+        case STATE_MEMDUMP_FILE:
+            return runtime_handle_memdump_file(env, tok, buf);
+        case STATE_MEMDUMP_ADDR:
+            return runtime_handle_memdump_addr(env, tok, buf);
+        case STATE_MEMDUMP_COUNT:
+            return runtime_handle_memdump_count(env, tok, buf);
+        case STATE_MEMCMP_FILE:
+            return runtime_handle_memcmp_file(env, tok, buf);
+        case STATE_MEMCMP_ADDR:
+            return runtime_handle_memcmp_addr(env, tok, buf);
         case STATE_RUN_CYCLES:
             return runtime_handle_run_cycles(env, tok, buf);
+        case STATE_REPEAT_COUNT:
+            return runtime_handle_repeat_count(env, tok, buf);
+        case STATE_REPEAT_VAR:
+            return runtime_handle_repeat_var(env, tok, buf);
+        case STATE_SET_VAR:
+            return runtime_handle_set_var(env, tok, buf);
+        case STATE_SET_VALUE:
+            return runtime_handle_set_value(env, tok, buf);
         case STATE_NEXT:
         case STATE_SUCCESS:
         case STATE_FAILURE:
@@ -383,8 +769,8 @@ state_t runtime_exec_token(env_t * env, const char * tok, const char * buf, stat
 }
 
 state_t runtime_handle_start(env_t * env, const char * tok, const char * buf) {
-    runtime_print(env, STYLE_CMD, "START\t");
-    runtime_print(env, STYLE_NONE, "%s\n", env->file);
+    runtime_prog_begin(env, OP_START);
+    runtime_prog_commit(env);
 
     return runtime_handle_cmd(env, tok, buf);
 }
@@ -434,12 +820,24 @@ state_t runtime_handle_cmd(env_t * env, const char * tok, const char * buf) {
         return runtime_handle_memset(env, tok, buf);
     } else if (strcmp(tok, ".memtest") == 0) {
         return runtime_handle_memtest(env, tok, buf);
+    } else if (strcmp(tok, ".memload") == 0) {
+        return runtime_handle_memload(env, tok, buf);
+    } else if (strcmp(tok, ".memdump") == 0) {
+        return runtime_handle_memdump(env, tok, buf);
+    } else if (strcmp(tok, ".memcmp") == 0) {
+        return runtime_handle_memcmp(env, tok, buf);
     } else if (strcmp(tok, ".reset") == 0) {
         return runtime_handle_reset(env, tok, buf);
     } else if (strcmp(tok, ".step") == 0) {
         return runtime_handle_step(env, tok, buf);
     } else if (strcmp(tok, ".run") == 0) {
         return runtime_handle_run(env, tok, buf);
+    } else if (strcmp(tok, ".repeat") == 0) {
+        return runtime_handle_repeat(env, tok, buf);
+    } else if (strcmp(tok, ".end") == 0) {
+        return runtime_handle_end(env, tok, buf);
+    } else if (strcmp(tok, ".set") == 0) {
+        return runtime_handle_set(env, tok, buf);
     }
 
     runtime_error(env, "Unrecognized command '%s'", tok);
@@ -451,15 +849,11 @@ state_t runtime_handle_nop(env_t * env, const char * tok, const char * buf) {
 }
 
 state_t runtime_handle_exit(env_t * env, const char * tok, const char * buf) {
-    runtime_print(env, STYLE_CMD, "EXIT\t");
+    runtime_prog_begin(env, OP_EXIT);
+    runtime_prog_commit(env);
 
-    if (env->success == RC_OK) {
-        runtime_print(env, STYLE_OK, "SUCCESS\n");
-        return STATE_SUCCESS;
-    } else {
-        runtime_print(env, STYLE_ERR, "FAILURE\n");
-        return STATE_FAILURE;
-    }
+    /* Nothing after an exit is reachable */
+    return STATE_SUCCESS;
 }
 
 state_t runtime_handle_device(env_t * env, const char * tok, const char * buf) {
@@ -467,7 +861,6 @@ state_t runtime_handle_device(env_t * env, const char * tok, const char * buf) {
 }
 
 state_t runtime_handle_device_file(env_t * env, const char * tok, const char * buf) {
-    device_t * device;
 
     /* Validate device library */
     char file[BUF_LEN];
@@ -478,24 +871,9 @@ state_t runtime_handle_device_file(env_t * env, const char * tok, const char * b
         return STATE_ERR;
     }
 
-    /* Load device */
-    device = runtime_device_init(file, id);
-
-    if (device == NULL) {
-        runtime_error(env, "Error loading device '%s' from library '%s'", id, file);
-        return STATE_ERR;
-    }
-
-    /* Clean up old device and register new one */
-    if (env->device) {
-        runtime_device_destroy(env->device);
-    }
-
-    env->device = device;
-
-    runtime_print(env, STYLE_CMD, "DEVICE\t");
-    runtime_print(env, STYLE_INFO, "%s\t", env->device->adapter->id);
-    runtime_print(env, STYLE_NONE, "(%s)\n", env->device->adapter->name);
+    /* Paths are resolved on execution, relative to the script being run */
+    runtime_prog_begin(env, OP_DEVICE)->str = runtime_prog_str(env, tok);
+    runtime_prog_commit(env);
 
     return STATE_CMD;
 }
@@ -505,13 +883,7 @@ state_t runtime_handle_exec(env_t * env, const char * tok, const char * buf) {
 }
 
 state_t runtime_handle_exec_file(env_t * env, const char * tok, const char * buf) {
-    state_t state;
     char file[BUF_LEN];
-    FILE * f;
-
-    /* Store current filename and line number */
-    const char * old_file = env->file;
-    size_t old_line = env->line;
 
     /* Validate filename */
     if (runtime_parse_file(env, tok, file) != RC_OK) {
@@ -519,91 +891,31 @@ state_t runtime_handle_exec_file(env_t * env, const char * tok, const char * buf
         return STATE_ERR;
     }
 
-    /* Open file for reading */
-    f = fopen(file, "r");
-
-    if (f == NULL) {
-        runtime_error(env, "Error opening file '%s': %s", tok, strerror(errno));
-        return STATE_ERR;
-    }
-
-    /* Initialize new filename and line number */
-    env->file = file;
-    env->line = 1;
-
-    /* Execute contents of file */
-    runtime_print(env, STYLE_CMD, "EXEC\t");
-    runtime_print(env, STYLE_NONE, "%s\n", file);
-    state = runtime_exec_stream(env, f);
-
-    /* Restore filename and line number */
-    env->file = old_file;
-    env->line = old_line;
-
-    /* Close file */
-    fclose(f);
-
-    if (state == STATE_ERR) {
-        runtime_error(env, "Error executing file '%s'", file);
-        return STATE_ERR;
-    }
-
-    runtime_print(env, STYLE_CMD, "DONE\t");
-    runtime_print(env, STYLE_NONE, "%s\n", file);
+    /* Paths are resolved on execution, relative to the script being run */
+    runtime_prog_begin(env, OP_EXEC)->str = runtime_prog_str(env, tok);
+    runtime_prog_commit(env);
 
     return STATE_CMD;
 }
 
 state_t runtime_handle_info(env_t * env, const char * tok, const char * buf) {
 
-    /* Print the remainder of the line */
-    runtime_print(env, STYLE_CMD, "INFO\t");
-    runtime_print(env, STYLE_TEXT, "%s", buf);
+    /* Store the remainder of the line */
+    runtime_prog_begin(env, OP_INFO)->str = runtime_prog_str(env, buf);
+    runtime_prog_commit(env);
 
     return STATE_NEXT;
 }
 
 state_t runtime_handle_pins(env_t * env, const char * tok, const char * buf) {
-    size_t p;
-
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
-    }
-
-    /* Print pin values */
-    runtime_print(env, STYLE_CMD, "PINS\t");
-
-    for (p = 0; p < env->pins_count; p++) {
-
-        /* Read from pin */
-        value_t val = env->device->adapter->read_pin(env->device->instance, env->pins[p]);
-
-        if (p > 0) {
-            runtime_print(env, STYLE_NONE, " ");
-        }
-
-        runtime_print(env, STYLE_NONE, "%s[", env->pins[p]);
-        runtime_print_value(env, STYLE_NONE, val);
-        runtime_print(env, STYLE_NONE, "]");
-    }
-
-    runtime_print(env, STYLE_NONE, "\n");
+    runtime_prog_begin(env, OP_PINS);
+    runtime_prog_commit(env);
 
     return STATE_CMD;
 }
 
 state_t runtime_handle_pindef(env_t * env, const char * tok, const char * buf) {
-
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
-    }
-
-    /* Reset pin list */
-    env->pins_count = 0;
+    runtime_prog_begin(env, OP_PINDEF);
 
     return STATE_PINDEF_PIN;
 }
@@ -621,52 +933,33 @@ state_t runtime_handle_pindef_pin(env_t * env, const char * tok, const char * bu
         return STATE_ERR;
     }
 
-    if (!env->device->adapter->can_read_pin(env->device->instance, tok)) {
-        runtime_error(env, "Unreadable pin '%s'", tok);
+    if (runtime_prog_instr(env)->args_count >= MAX_PINS) {
+        runtime_error(env, "Too many pins, at most %d are allowed", MAX_PINS);
         return STATE_ERR;
     }
 
     /* Register pin */
-    env->pins[env->pins_count++] = strcpy(&env->pins_buf[env->pins_count * PIN_LEN], tok);
+    runtime_prog_arg(env)->str = runtime_prog_str(env, tok);
 
     return STATE_PINDEF_PIN;
 }
 
 state_t runtime_handle_pindef_end(env_t * env, const char * tok, const char * buf) {
-    size_t p;
-
-    /* Print pin list */
-    runtime_print(env, STYLE_CMD, "PINDEF\t");
-
-    for (p = 0; p < env->pins_count; p++) {
-        if (p > 0) {
-            runtime_print(env, STYLE_NONE, " ");
-        }
-
-        runtime_print(env, STYLE_NONE, "%s", env->pins[p]);
-    }
-
-    runtime_print(env, STYLE_NONE, "\n");
+    runtime_prog_commit(env);
 
     return runtime_handle_cmd(env, tok, buf);
 }
 
 state_t runtime_handle_pintest(env_t * env, const char * tok, const char * buf) {
-
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
-    }
-
-    /* Reset pin tests */
-    env->pin_tests_count = 0;
+    runtime_prog_begin(env, OP_PINTEST);
 
     return STATE_PINTEST_DATA;
 }
 
 state_t runtime_handle_pintest_data(env_t * env, const char * tok, const char * buf) {
     test_t test;
+    size_t var;
+    arg_t * arg;
 
     /* Check for end condition */
     if (tok[0] == '.') {
@@ -674,51 +967,630 @@ state_t runtime_handle_pintest_data(env_t * env, const char * tok, const char *
     }
 
     /* Check for an available pin */
-    if (env->pin_tests_count >= env->pins_count) {
-        runtime_error(env, "Only %zu pins specified\n", env->pins_count);
+    if (runtime_prog_instr(env)->args_count >= MAX_PINS) {
+        runtime_error(env, "Too many pin test values, at most %d are allowed", MAX_PINS);
         return STATE_ERR;
     }
 
     /* Validate test value */
-    if (runtime_parse_test(env, tok, &test) != RC_OK) {
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK) {
         runtime_error(env, "Expected pin test value, found '%s'\n", tok);
         return STATE_ERR;
     }
 
     /* Register test value */
-    env->pin_tests[env->pin_tests_count++] = test;
+    arg = runtime_prog_arg(env);
+    arg->test = test;
+    arg->var = var;
 
     return STATE_PINTEST_DATA;
 }
 
 state_t runtime_handle_pintest_end(env_t * env, const char * tok, const char * buf) {
-    size_t p;
+    runtime_prog_commit(env);
 
-    /* Print test values */
-    runtime_print(env, STYLE_CMD, "PINTEST\t");
-
-    for (p = 0; p < env->pin_tests_count; p++) {
-        if (p > 0) {
-            runtime_print(env, STYLE_NONE, " ");
-        }
+    return runtime_handle_cmd(env, tok, buf);
+}
 
-        runtime_print(env, STYLE_NONE, "%s[", env->pins[p]);
-        runtime_print_test(env, STYLE_NONE, env->pin_tests[p]);
-        runtime_print(env, STYLE_NONE, "]");
-    }
+state_t runtime_handle_memset(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_MEMSET);
+
+    return STATE_MEMSET_ADDR;
+}
+
+state_t runtime_handle_memset_addr(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate address */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected address, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Register reference address */
+    runtime_prog_instr(env)->addr = test.data;
+    runtime_prog_instr(env)->addr_var = var;
+
+    return STATE_MEMSET_DATA;
+}
+
+state_t runtime_handle_memset_data(env_t * env, const char * tok, const char * buf) {
+    test_t test;
+    size_t var;
+    arg_t * arg;
+
+    /* Check for end condition */
+    if (tok[0] == '.') {
+        return runtime_handle_memset_end(env, tok, buf);
+    }
+
+    /* Validate word */
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected word, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Register word */
+    arg = runtime_prog_arg(env);
+    arg->test = test;
+    arg->var = var;
+
+    return STATE_MEMSET_DATA;
+}
+
+state_t runtime_handle_memset_end(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_commit(env);
+
+    return runtime_handle_cmd(env, tok, buf);
+}
+
+state_t runtime_handle_memtest(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_MEMTEST);
+
+    return STATE_MEMTEST_ADDR;
+}
+
+state_t runtime_handle_memtest_addr(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate address */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected address, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Register reference address */
+    runtime_prog_instr(env)->addr = test.data;
+    runtime_prog_instr(env)->addr_var = var;
+
+    return STATE_MEMTEST_DATA;
+}
+
+state_t runtime_handle_memtest_data(env_t * env, const char * tok, const char * buf) {
+    test_t test;
+    size_t var;
+    arg_t * arg;
+
+    /* Check for end condition */
+    if (tok[0] == '.') {
+        return runtime_handle_memtest_end(env, tok, buf);
+    }
+
+    /* Validate test word */
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK) {
+        runtime_error(env, "Expected test word, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Register test word */
+    arg = runtime_prog_arg(env);
+    arg->test = test;
+    arg->var = var;
+
+    return STATE_MEMTEST_DATA;
+}
+
+state_t runtime_handle_memtest_end(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_commit(env);
+
+    return runtime_handle_cmd(env, tok, buf);
+}
+
+state_t runtime_handle_memload(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_MEMLOAD);
+
+    return STATE_MEMLOAD_FILE;
+}
+
+state_t runtime_handle_memload_file(env_t * env, const char * tok, const char * buf) {
+    char file[BUF_LEN];
+
+    /* Validate filename */
+    if (runtime_parse_file(env, tok, file) != RC_OK) {
+        runtime_error(env, "Expected filename, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->str = runtime_prog_str(env, tok);
+
+    return STATE_MEMLOAD_ADDR;
+}
+
+state_t runtime_handle_memload_addr(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate address */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected address, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->addr = test.data;
+    runtime_prog_instr(env)->addr_var = var;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_memdump(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_MEMDUMP);
+
+    return STATE_MEMDUMP_FILE;
+}
+
+state_t runtime_handle_memdump_file(env_t * env, const char * tok, const char * buf) {
+    char file[BUF_LEN];
+
+    /* Validate filename */
+    if (runtime_parse_file(env, tok, file) != RC_OK) {
+        runtime_error(env, "Expected filename, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->str = runtime_prog_str(env, tok);
+
+    return STATE_MEMDUMP_ADDR;
+}
+
+state_t runtime_handle_memdump_addr(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate address */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected address, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->addr = test.data;
+    runtime_prog_instr(env)->addr_var = var;
+
+    return STATE_MEMDUMP_COUNT;
+}
+
+state_t runtime_handle_memdump_count(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate word count */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected word count, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->count = test.data;
+    runtime_prog_instr(env)->count_var = var;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_memcmp(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_MEMCMP);
+
+    return STATE_MEMCMP_FILE;
+}
+
+state_t runtime_handle_memcmp_file(env_t * env, const char * tok, const char * buf) {
+    char file[BUF_LEN];
+
+    /* Validate filename */
+    if (runtime_parse_file(env, tok, file) != RC_OK) {
+        runtime_error(env, "Expected filename, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->str = runtime_prog_str(env, tok);
+
+    return STATE_MEMCMP_ADDR;
+}
+
+state_t runtime_handle_memcmp_addr(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate address */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected address, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->addr = test.data;
+    runtime_prog_instr(env)->addr_var = var;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_reset(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_RESET);
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_step(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_STEP);
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_run(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_RUN);
+
+    return STATE_RUN_CYCLES;
+}
+
+state_t runtime_handle_run_cycles(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate cycle count */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected cycle count, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->count = test.data;
+    runtime_prog_instr(env)->count_var = var;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_repeat(env_t * env, const char * tok, const char * buf) {
+
+    /* Check for an available block */
+    if (env->prog->blocks_count >= MAX_BLOCKS) {
+        runtime_error(env, "Too many nested blocks, at most %d are allowed", MAX_BLOCKS);
+        return STATE_ERR;
+    }
+
+    runtime_prog_begin(env, OP_REPEAT);
+
+    return STATE_REPEAT_COUNT;
+}
+
+state_t runtime_handle_repeat_count(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate repeat count */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected repeat count, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->count = test.data;
+    runtime_prog_instr(env)->count_var = var;
+
+    return STATE_REPEAT_VAR;
+}
+
+state_t runtime_handle_repeat_var(env_t * env, const char * tok, const char * buf) {
+    prog_t * prog = env->prog;
+    int named = (tok[0] != '.');
+
+    /* Validate optional counter name */
+    if (named && runtime_parse_var(env, tok) != RC_OK) {
+        runtime_error(env, "Expected counter name, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Unnamed loops still need a counter */
+    runtime_prog_instr(env)->var = runtime_prog_var(env, named ? tok : NULL, 1);
+
+    /* Open block */
+    prog->blocks[prog->blocks_count++] = prog->instrs_count;
+    runtime_prog_commit(env);
+
+    return named ? STATE_CMD : runtime_handle_cmd(env, tok, buf);
+}
+
+state_t runtime_handle_end(env_t * env, const char * tok, const char * buf) {
+    prog_t * prog = env->prog;
+    instr_t * instr;
+    size_t repeat;
+
+    /* Close the innermost block */
+    if (prog->blocks_count == 0) {
+        runtime_error(env, "Unexpected .end outside of a .repeat block");
+        return STATE_ERR;
+    }
+
+    repeat = prog->blocks[--prog->blocks_count];
+
+    /* Link the block ends to each other, the end holds the evaluated repeat count */
+    instr = runtime_prog_begin(env, OP_END);
+    instr->jump = repeat;
+    instr->var = runtime_prog_var(env, NULL, 1);
+
+    prog->instrs[repeat].jump = prog->instrs_count;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_handle_set(env_t * env, const char * tok, const char * buf) {
+    runtime_prog_begin(env, OP_SET);
+
+    return STATE_SET_VAR;
+}
+
+state_t runtime_handle_set_var(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate variable name */
+    if (runtime_parse_var(env, tok) != RC_OK) {
+        runtime_error(env, "Expected variable name, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    /* Variables are defined on first assignment and start at zero */
+    runtime_prog_instr(env)->var = runtime_prog_var(env, tok, 1);
+
+    return STATE_SET_VALUE;
+}
+
+state_t runtime_handle_set_value(env_t * env, const char * tok, const char * buf) {
+
+    /* Validate value */
+    test_t test;
+    size_t var;
+
+    if (runtime_parse_operand(env, tok, &test, &var) != RC_OK || ~test.mask) {
+        runtime_error(env, "Expected value, found '%s'\n", tok);
+        return STATE_ERR;
+    }
+
+    runtime_prog_instr(env)->count = test.data;
+    runtime_prog_instr(env)->count_var = var;
+    runtime_prog_commit(env);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_start(env_t * env, prog_t * prog, const instr_t * instr) {
+    runtime_print(env, STYLE_CMD, "START\t");
+    runtime_print(env, STYLE_NONE, "%s\n", env->file);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_exit(env_t * env, prog_t * prog, const instr_t * instr) {
+    runtime_print(env, STYLE_CMD, "EXIT\t");
+
+    if (env->success == RC_OK) {
+        runtime_print(env, STYLE_OK, "SUCCESS\n");
+        return STATE_SUCCESS;
+    } else {
+        runtime_print(env, STYLE_ERR, "FAILURE\n");
+        return STATE_FAILURE;
+    }
+}
+
+state_t runtime_op_device(env_t * env, prog_t * prog, const instr_t * instr) {
+    device_t * device;
+
+    /* Locate device library */
+    char file[BUF_LEN];
+    char id[BUF_LEN];
+
+    runtime_parse_device(env, &prog->strs[instr->str], file, id);
+
+    /* Load device */
+    device = runtime_device_init(file, id);
+
+    if (device == NULL) {
+        runtime_error(env, "Error loading device '%s' from library '%s'", id, file);
+        return STATE_ERR;
+    }
+
+    /* Clean up old device and register new one */
+    if (env->device) {
+        runtime_device_destroy(env->device);
+    }
+
+    env->device = device;
+
+    runtime_print(env, STYLE_CMD, "DEVICE\t");
+    runtime_print(env, STYLE_INFO, "%s\t", env->device->adapter->id);
+    runtime_print(env, STYLE_NONE, "(%s)\n", env->device->adapter->name);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_exec(env_t * env, prog_t * prog, const instr_t * instr) {
+    state_t state;
+    char file[BUF_LEN];
+    prog_t * sub;
+
+    /* Store current filename, line number and program counter */
+    const char * old_file = env->file;
+    size_t old_line = env->line;
+    size_t old_pc = env->pc;
+
+    /* Resolve path relative to the script being run */
+    runtime_parse_file(env, &prog->strs[instr->str], file);
+
+    /* Compile file, or load it from the cache */
+    sub = runtime_load(env, file);
+
+    if (sub == NULL) {
+        runtime_error(env, "Error executing file '%s'", file);
+        return STATE_ERR;
+    }
+
+    /* Initialize new filename */
+    env->file = file;
+
+    /* Execute contents of file */
+    runtime_print(env, STYLE_CMD, "EXEC\t");
+    runtime_print(env, STYLE_NONE, "%s\n", file);
+    state = runtime_exec_prog(env, sub);
+
+    /* Restore filename, line number and program counter */
+    env->file = old_file;
+    env->line = old_line;
+    env->pc = old_pc;
+
+    runtime_prog_destroy(sub);
+
+    if (state == STATE_ERR) {
+        runtime_error(env, "Error executing file '%s'", file);
+        return STATE_ERR;
+    }
+
+    runtime_print(env, STYLE_CMD, "DONE\t");
+    runtime_print(env, STYLE_NONE, "%s\n", file);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_info(env_t * env, prog_t * prog, const instr_t * instr) {
+
+    /* Print the remainder of the line */
+    runtime_print(env, STYLE_CMD, "INFO\t");
+    runtime_print(env, STYLE_TEXT, "%s", &prog->strs[instr->str]);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_pins(env_t * env, prog_t * prog, const instr_t * instr) {
+    size_t p;
+
+    /* Print pin values */
+    runtime_print(env, STYLE_CMD, "PINS\t");
+
+    for (p = 0; p < env->pins_count; p++) {
+
+        /* Read from pin */
+        value_t val = runtime_read_pin(env, p);
+
+        if (p > 0) {
+            runtime_print(env, STYLE_NONE, " ");
+        }
+
+        runtime_print(env, STYLE_NONE, "%s[", env->pins[p]);
+        runtime_print_value(env, STYLE_NONE, val);
+        runtime_print(env, STYLE_NONE, "]");
+    }
+
+    runtime_print(env, STYLE_NONE, "\n");
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_pindef(env_t * env, prog_t * prog, const instr_t * instr) {
+    const arg_t * args = &prog->args[instr->args];
+    size_t p;
+
+    /* Reset pin list */
+    env->pins_count = 0;
+
+    for (p = 0; p < instr->args_count; p++) {
+        const char * pin = &prog->strs[args[p].str];
+
+        /* Validate pin */
+        if (!env->device->adapter->can_read_pin(env->device->instance, pin)) {
+            runtime_error(env, "Unreadable pin '%s'", pin);
+            return STATE_ERR;
+        }
+
+        /* Register pin */
+        env->pins[p] = strcpy(&env->pins_buf[p * PIN_LEN], pin);
+        env->pins_count++;
+
+        /* Resolve its handle once, if the adapter has handles */
+        if (env->device->adapter->resolve_pin != NULL) {
+            env->pin_handles[p] = env->device->adapter->resolve_pin(env->device->instance, pin);
+        } else {
+            env->pin_handles[p] = -1;
+        }
+    }
+
+    /* Print pin list */
+    runtime_print(env, STYLE_CMD, "PINDEF\t");
+
+    for (p = 0; p < env->pins_count; p++) {
+        if (p > 0) {
+            runtime_print(env, STYLE_NONE, " ");
+        }
+
+        runtime_print(env, STYLE_NONE, "%s", env->pins[p]);
+    }
+
+    runtime_print(env, STYLE_NONE, "\n");
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_pintest(env_t * env, prog_t * prog, const instr_t * instr) {
+    const arg_t * args = &prog->args[instr->args];
+    size_t p;
+
+    /* Check for available pins */
+    if (instr->args_count > env->pins_count) {
+        runtime_error(env, "Only %zu pins specified\n", env->pins_count);
+        return STATE_ERR;
+    }
+
+    /* Print test values */
+    runtime_print(env, STYLE_CMD, "PINTEST\t");
+
+    for (p = 0; p < instr->args_count; p++) {
+        if (p > 0) {
+            runtime_print(env, STYLE_NONE, " ");
+        }
+
+        runtime_print(env, STYLE_NONE, "%s[", env->pins[p]);
+        runtime_print_test(env, STYLE_NONE, runtime_eval_arg(prog, &args[p]));
+        runtime_print(env, STYLE_NONE, "]");
+    }
 
     runtime_print(env, STYLE_NONE, "\n");
 
     /* Compare pin list */
     runtime_print(env, STYLE_NONE, "       \t");
 
-    for (p = 0; p < env->pin_tests_count; p++) {
+    for (p = 0; p < instr->args_count; p++) {
 
         /* Read from pin */
-        value_t val = env->device->adapter->read_pin(env->device->instance, env->pins[p]);
+        value_t val = runtime_read_pin(env, p);
 
         /* Compare */
-        rc_t rc = runtime_test(env, val, env->pin_tests[p]);
+        rc_t rc = runtime_test(env, val, runtime_eval_arg(prog, &args[p]));
         style_t style = (rc == RC_OK) ? STYLE_OK : STYLE_ERR;
 
         if (p > 0) {
@@ -732,266 +1604,653 @@ state_t runtime_handle_pintest_end(env_t * env, const char * tok, const char * b
 
     runtime_print(env, STYLE_NONE, "\n");
 
-    return runtime_handle_cmd(env, tok, buf);
+    return STATE_CMD;
 }
 
-state_t runtime_handle_memset(env_t * env, const char * tok, const char * buf) {
+state_t runtime_op_memset(env_t * env, prog_t * prog, const instr_t * instr) {
+    const arg_t * args = &prog->args[instr->args];
+    unsigned int base = runtime_eval(prog, instr->addr, instr->addr_var);
+    size_t i;
+
+    runtime_print(env, STYLE_CMD, "MEMSET\t");
+    runtime_print_addr(env, STYLE_NONE, base);
+    runtime_print(env, STYLE_NONE, "\n");
+
+    for (i = 0; i < instr->args_count; i++) {
+        unsigned int addr = base + i;
+        unsigned int word = runtime_eval(prog, args[i].test.data, args[i].var);
+
+        /* Write to memory */
+        env->device->adapter->write_mem(env->device->instance, addr, word);
+
+        runtime_print(env, STYLE_NONE, "\t");
+        runtime_print_addr(env, STYLE_NONE, addr);
+        runtime_print(env, STYLE_NONE, "\t");
+        runtime_print_word(env, STYLE_NONE, word);
+        runtime_print(env, STYLE_NONE, "\n");
+    }
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_memtest(env_t * env, prog_t * prog, const instr_t * instr) {
+    size_t word_bytes = (env->device->adapter->mem_word_width + 7) / 8;
+    const arg_t * args = &prog->args[instr->args];
+    unsigned int base = runtime_eval(prog, instr->addr, instr->addr_var);
+    const unsigned char * block;
+    unsigned char * data;
+    value_t word;
+    size_t i, b;
+
+    runtime_print(env, STYLE_CMD, "MEMTEST\t");
+    runtime_print_addr(env, STYLE_NONE, base);
+    runtime_print(env, STYLE_NONE, "\n");
 
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
+    /* Read the tested range from memory in one block */
+    data = malloc(word_bytes * instr->args_count + 1);
+
+    if (data == NULL) {
+        runtime_error(env, "Error allocating %lu words", (unsigned long)instr->args_count);
         return STATE_ERR;
     }
 
-    /* Reset memory reference */
-    env->mem_addr = 0;
-    env->mem_offset = 0;
+    block = runtime_read_mem_block(env, base, data, instr->args_count);
 
-    return STATE_MEMSET_ADDR;
+    /* Words are reported with the width and base the adapter uses for single reads */
+    word = env->device->adapter->read_mem(env->device->instance, base);
+
+    for (i = 0; i < instr->args_count; i++) {
+        unsigned int addr = base + i;
+        test_t test = runtime_eval_arg(prog, &args[i]);
+        value_t val;
+        style_t style;
+
+        val.data = 0;
+        val.bits = word.bits;
+        val.base = word.base;
+
+        for (b = 0; b < word_bytes; b++) {
+            val.data |= (unsigned int)block[i * word_bytes + b] << (8 * b);
+        }
+
+        /* Compare */
+        style = (runtime_test(env, val, test) == RC_OK) ? STYLE_OK : STYLE_ERR;
+
+        runtime_print(env, STYLE_NONE, "\t");
+        runtime_print_addr(env, STYLE_NONE, addr);
+        runtime_print(env, STYLE_NONE, "\t");
+        runtime_print_test(env, STYLE_NONE, test);
+        runtime_print(env, STYLE_NONE, "\t");
+        runtime_print_value(env, style, val);
+        runtime_print(env, STYLE_NONE, "\n");
+    }
+
+    free(data);
+
+    return STATE_CMD;
 }
 
-state_t runtime_handle_memset_addr(env_t * env, const char * tok, const char * buf) {
+state_t runtime_op_memload(env_t * env, prog_t * prog, const instr_t * instr) {
+    char file[BUF_LEN];
+    unsigned int addr = runtime_eval(prog, instr->addr, instr->addr_var);
+    size_t count = 0;
+    const char * ext;
+    rc_t rc;
 
-    /* Validate address */
-    value_t val;
-    unsigned int addr;
+    /* Resolve path relative to the script being run */
+    runtime_parse_file(env, &prog->strs[instr->str], file);
 
-    if (runtime_parse_value(env, tok, &val) == RC_OK) {
-        addr = val.data;
+    /* Load image as Intel HEX or raw binary depending on file extension */
+    ext = strrchr(file, '.');
+
+    if (ext != NULL && (strcmp(ext, ".hex") == 0 || strcmp(ext, ".ihx") == 0)) {
+        rc = runtime_memload_hex(env, file, addr, &count);
     } else {
-        runtime_error(env, "Expected address, found '%s'\n", tok);
+        rc = runtime_memload_bin(env, file, addr, &count);
+    }
+
+    /* The loaders report the specific error */
+    if (rc != RC_OK) {
         return STATE_ERR;
     }
 
-    /* Register reference address */
-    env->mem_addr = addr;
+    runtime_print(env, STYLE_CMD, "MEMLOAD\t");
+    runtime_print_addr(env, STYLE_NONE, addr);
+    runtime_print(env, STYLE_NONE, "\t%s\t", file);
+    runtime_print(env, STYLE_INFO, "%lu words\n", (unsigned long)count);
 
-    runtime_print(env, STYLE_CMD, "MEMSET\t");
+    return STATE_CMD;
+}
+
+state_t runtime_op_memdump(env_t * env, prog_t * prog, const instr_t * instr) {
+    size_t word_bytes = (env->device->adapter->mem_word_width + 7) / 8;
+    size_t chunk_words = BUF_LEN / word_bytes;
+    unsigned char data[BUF_LEN];
+    char file[BUF_LEN];
+    unsigned int base = runtime_eval(prog, instr->addr, instr->addr_var);
+    unsigned int addr = base;
+    size_t count = runtime_eval(prog, instr->count, instr->count_var);
+    size_t left;
+    FILE * f;
+
+    /* Resolve path relative to the script being run */
+    runtime_parse_file(env, &prog->strs[instr->str], file);
+
+    /* Open file for writing */
+    f = fopen(file, "wb");
+
+    if (f == NULL) {
+        runtime_error(env, "Error opening file '%s': %s", file, strerror(errno));
+        return STATE_ERR;
+    }
+
+    /* Stream memory to the file in blocks */
+    for (left = count; left > 0; ) {
+        size_t words = left < chunk_words ? left : chunk_words;
+        const unsigned char * block = runtime_read_mem_block(env, addr, data, words);
+
+        if (fwrite(block, word_bytes, words, f) != words) {
+            runtime_error(env, "Error writing file '%s': %s", file, strerror(errno));
+            fclose(f);
+            return STATE_ERR;
+        }
+
+        addr += words;
+        left -= words;
+    }
+
+    fclose(f);
+
+    runtime_print(env, STYLE_CMD, "MEMDUMP\t");
+    runtime_print_addr(env, STYLE_NONE, base);
+    runtime_print(env, STYLE_NONE, "\t%s\t", file);
+    runtime_print(env, STYLE_INFO, "%lu words\n", (unsigned long)count);
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_memcmp(env_t * env, prog_t * prog, const instr_t * instr) {
+    size_t word_bytes = (env->device->adapter->mem_word_width + 7) / 8;
+    const unsigned char * block;
+    unsigned char * image;
+    unsigned char * data;
+    char file[BUF_LEN];
+    unsigned int addr = runtime_eval(prog, instr->addr, instr->addr_var);
+    size_t count, i;
+
+    /* Resolve path relative to the script being run */
+    runtime_parse_file(env, &prog->strs[instr->str], file);
+
+    /* Read the reference image */
+    if (runtime_read_image(env, file, &image, &count) != RC_OK) {
+        return STATE_ERR;
+    }
+
+    runtime_print(env, STYLE_CMD, "MEMCMP\t");
     runtime_print_addr(env, STYLE_NONE, addr);
-    runtime_print(env, STYLE_NONE, "\n");
+    runtime_print(env, STYLE_NONE, "\t%s\t", file);
 
-    return STATE_MEMSET_DATA;
+    /* Compare the whole range at once */
+    data = malloc(word_bytes * count + 1);
+
+    if (data == NULL) {
+        runtime_error(env, "Error allocating %lu words", (unsigned long)count);
+        free(image);
+        return STATE_ERR;
+    }
+
+    block = runtime_read_mem_block(env, addr, data, count);
+
+    if (memcmp(block, image, word_bytes * count) == 0) {
+        runtime_print(env, STYLE_OK, "%lu words\n", (unsigned long)count);
+    } else {
+        size_t diffs = 0;
+
+        env->success = RC_ERR;
+
+        /* Locate the first mismatch for the report */
+        for (i = 0; i < count; i++) {
+            if (memcmp(&block[i * word_bytes], &image[i * word_bytes], word_bytes) != 0) {
+                if (diffs++ == 0) {
+                    addr += i;
+                }
+            }
+        }
+
+        runtime_print(env, STYLE_ERR, "%lu / %lu words differ from ",
+                      (unsigned long)diffs, (unsigned long)count);
+        runtime_print_addr(env, STYLE_ERR, addr);
+        runtime_print(env, STYLE_NONE, "\n");
+    }
+
+    free(data);
+    free(image);
+
+    return STATE_CMD;
 }
 
-state_t runtime_handle_memset_data(env_t * env, const char * tok, const char * buf) {
-    value_t val;
-    unsigned int word;
-    unsigned int addr;
+state_t runtime_op_reset(env_t * env, prog_t * prog, const instr_t * instr) {
 
-    /* Check for end condition */
-    if (tok[0] == '.') {
-        return runtime_handle_memset_end(env, tok, buf);
+    /* Reset intance */
+    env->device->adapter->reset(env->device->instance);
+
+    runtime_print(env, STYLE_CMD, "RESET\n");
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_step(env_t * env, prog_t * prog, const instr_t * instr) {
+
+    /* Step instance */
+    env->device->adapter->step(env->device->instance);
+
+    runtime_print(env, STYLE_CMD, "STEP\n");
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_run(env_t * env, prog_t * prog, const instr_t * instr) {
+    size_t cycles = runtime_eval(prog, instr->count, instr->count_var);
+    clock_t start, elapsed;
+    double khz;
+
+    /* Start run clock */
+    start = clock();
+
+    /* Run instance */
+    env->device->adapter->run(env->device->instance, cycles);
+
+    /* Capture clock speed */
+    elapsed = clock() - start;
+    khz = .001 * CLOCKS_PER_SEC * cycles / elapsed;
+
+    runtime_print(env, STYLE_CMD, "RUN\t");
+    runtime_print(env, STYLE_NONE, "%zu\t@\t", cycles);
+
+    if (khz > 1000) {
+        runtime_print(env, STYLE_INFO, "%.3f MHz\n", khz / 1000);
+    } else {
+        runtime_print(env, STYLE_INFO, "%.3f kHz\n", khz);
     }
 
-    /* Validate word */
-    if (runtime_parse_value(env, tok, &val) == RC_OK) {
-        word = val.data;
+    return STATE_CMD;
+}
+
+state_t runtime_op_repeat(env_t * env, prog_t * prog, const instr_t * instr) {
+    unsigned int count = runtime_eval(prog, instr->count, instr->count_var);
+
+    /* Reset counter and latch the repeat count into the matching .end */
+    prog->vals[instr->var - 1] = 0;
+    prog->vals[prog->instrs[instr->jump].var - 1] = count;
+
+    /* Skip the block entirely if there is nothing to repeat */
+    if (count == 0) {
+        env->pc = instr->jump + 1;
+    }
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_end(env_t * env, prog_t * prog, const instr_t * instr) {
+    const instr_t * repeat = &prog->instrs[instr->jump];
+
+    /* Loop back to the start of the block until the count is reached */
+    if (++prog->vals[repeat->var - 1] < prog->vals[instr->var - 1]) {
+        env->pc = instr->jump + 1;
+    }
+
+    return STATE_CMD;
+}
+
+state_t runtime_op_set(env_t * env, prog_t * prog, const instr_t * instr) {
+    prog->vals[instr->var - 1] = runtime_eval(prog, instr->count, instr->count_var);
+
+    return STATE_CMD;
+}
+
+unsigned int runtime_eval(const prog_t * prog, unsigned int data, size_t var) {
+    return var ? data + prog->vals[var - 1] : data;
+}
+
+test_t runtime_eval_arg(const prog_t * prog, const arg_t * arg) {
+    test_t test = arg->test;
+
+    test.data = runtime_eval(prog, test.data, arg->var);
+
+    return test;
+}
+
+rc_t runtime_test(env_t * env, value_t val, test_t test) {
+    if (test.data == (val.data & test.mask)) {
+        return RC_OK;
     } else {
-        runtime_error(env, "Expected word, found '%s'\n", tok);
-        return STATE_ERR;
+        env->success = RC_ERR;
+
+        return RC_ERR;
+    }
+}
+
+value_t runtime_read_pin(const env_t * env, size_t p) {
+    const adapter_t * adapter = env->device->adapter;
+
+    /* Read through the resolved handle, or by name if the adapter has no handles */
+    if (adapter->read_pin_handle != NULL && env->pin_handles[p] >= 0) {
+        return adapter->read_pin_handle(env->device->instance, env->pin_handles[p]);
+    }
+
+    return adapter->read_pin(env->device->instance, env->pins[p]);
+}
+
+rc_t runtime_read_image(const env_t * env, const char * file,
+                        unsigned char ** data, size_t * count) {
+    size_t word_bytes = (env->device->adapter->mem_word_width + 7) / 8;
+    long len;
+
+    /* Open file for reading */
+    FILE * f = fopen(file, "rb");
+
+    if (f == NULL) {
+        runtime_error(env, "Error opening file '%s': %s", file, strerror(errno));
+        return RC_ERR;
+    }
+
+    /* Determine image size */
+    if (fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) < 0 || fseek(f, 0, SEEK_SET) != 0) {
+        runtime_error(env, "Error reading file '%s': %s", file, strerror(errno));
+        fclose(f);
+        return RC_ERR;
+    }
+
+    if (len % word_bytes != 0) {
+        runtime_error(env, "Image size %ld is not a multiple of the word size", len);
+        fclose(f);
+        return RC_ERR;
+    }
+
+    /* Read the whole image */
+    *data = malloc(len > 0 ? len : 1);
+
+    if (*data == NULL) {
+        runtime_error(env, "Error allocating %ld bytes for image '%s'", len, file);
+        fclose(f);
+        return RC_ERR;
+    }
+
+    if (fread(*data, 1, len, f) != (size_t)len) {
+        runtime_error(env, "Error reading file '%s'", file);
+        free(*data);
+        fclose(f);
+        return RC_ERR;
     }
 
-    /* Write to memory */
-    addr = env->mem_addr + env->mem_offset++;
+    *count = len / word_bytes;
+
+    fclose(f);
+
+    return RC_OK;
+}
+
+const unsigned char * runtime_read_mem_block(const env_t * env, unsigned int addr,
+                                             unsigned char * data, size_t count) {
+    const adapter_t * adapter = env->device->adapter;
+    const unsigned char * mem;
+    size_t avail;
+
+    /* Use the device memory directly when the whole range is contiguous */
+    if (adapter->get_mem != NULL) {
+        mem = adapter->get_mem(env->device->instance, addr, &avail);
 
-    env->device->adapter->write_mem(env->device->instance, addr, word);
+        if (mem != NULL && avail >= count) {
+            return mem;
+        }
+    }
 
-    runtime_print(env, STYLE_NONE, "\t");
-    runtime_print_addr(env, STYLE_NONE, addr);
-    runtime_print(env, STYLE_NONE, "\t");
-    runtime_print_word(env, STYLE_NONE, word);
-    runtime_print(env, STYLE_NONE, "\n");
+    /* Otherwise copy the range into the caller's buffer */
+    if (adapter->read_mem_block != NULL) {
+        adapter->read_mem_block(env->device->instance, addr, data, count);
+    } else {
+        size_t word_bytes = (adapter->mem_word_width + 7) / 8;
+        size_t i, b;
 
-    return STATE_MEMSET_DATA;
-}
+        for (i = 0; i < count; i++) {
+            unsigned int word = adapter->read_mem(env->device->instance, addr + i).data;
 
-state_t runtime_handle_memset_end(env_t * env, const char * tok, const char * buf) {
-    return runtime_handle_cmd(env, tok, buf);
+            for (b = 0; b < word_bytes; b++) {
+                data[i * word_bytes + b] = (unsigned char)(word >> (8 * b));
+            }
+        }
+    }
+
+    return data;
 }
 
-state_t runtime_handle_memtest(env_t * env, const char * tok, const char * buf) {
+void runtime_write_mem_block(const env_t * env, unsigned int addr,
+                             const unsigned char * data, size_t count) {
+    const adapter_t * adapter = env->device->adapter;
+    size_t word_bytes = (adapter->mem_word_width + 7) / 8;
+    size_t i, b;
 
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
+    if (adapter->write_mem_block != NULL) {
+        adapter->write_mem_block(env->device->instance, addr, data, count);
+        return;
     }
 
-    /* Reset memory reference */
-    env->mem_addr = 0;
-    env->mem_offset = 0;
+    /* Fall back to writing word by word */
+    for (i = 0; i < count; i++) {
+        unsigned int word = 0;
 
-    return STATE_MEMTEST_ADDR;
-}
+        for (b = 0; b < word_bytes; b++) {
+            word |= (unsigned int)data[i * word_bytes + b] << (8 * b);
+        }
 
-state_t runtime_handle_memtest_addr(env_t * env, const char * tok, const char * buf) {
+        adapter->write_mem(env->device->instance, addr + i, word);
+    }
+}
 
-    /* Validate address */
-    value_t val;
-    unsigned int addr;
+rc_t runtime_memload_bin(const env_t * env, const char * file, unsigned int addr,
+                         size_t * count) {
+    unsigned char * data;
 
-    if (runtime_parse_value(env, tok, &val) == RC_OK) {
-        addr = val.data;
-    } else {
-        runtime_error(env, "Expected address, found '%s'\n", tok);
-        return STATE_ERR;
+    if (runtime_read_image(env, file, &data, count) != RC_OK) {
+        return RC_ERR;
     }
 
-    /* Register reference address */
-    env->mem_addr = addr;
+    /* Write the whole image to memory in one block */
+    runtime_write_mem_block(env, addr, data, *count);
 
-    runtime_print(env, STYLE_CMD, "MEMTEST\t");
-    runtime_print_addr(env, STYLE_NONE, addr);
-    runtime_print(env, STYLE_NONE, "\n");
+    free(data);
 
-    return STATE_MEMTEST_DATA;
+    return RC_OK;
 }
 
-state_t runtime_handle_memtest_data(env_t * env, const char * tok, const char * buf) {
-    test_t test;
-    value_t val;
-    unsigned int addr;
-    rc_t rc;
-    style_t style;
+rc_t runtime_memload_hex(const env_t * env, const char * file, unsigned int addr,
+                         size_t * count) {
+    size_t word_bytes = (env->device->adapter->mem_word_width + 7) / 8;
+    unsigned long base = 0;
+    unsigned char rec[BUF_LEN / 2];
+    char line[BUF_LEN];
+    size_t line_num = 0;
+    rc_t rc = RC_OK;
 
-    /* Check for end condition */
-    if (tok[0] == '.') {
-        return runtime_handle_memtest_end(env, tok, buf);
-    }
+    /* Open file for reading */
+    FILE * f = fopen(file, "r");
 
-    /* Validate test word */
-    if (runtime_parse_test(env, tok, &test) != RC_OK) {
-        runtime_error(env, "Expected test word, found '%s'\n", tok);
-        return STATE_ERR;
+    if (f == NULL) {
+        runtime_error(env, "Error opening file '%s': %s", file, strerror(errno));
+        return RC_ERR;
     }
 
-    /* Read from memory */
-    addr = env->mem_addr + env->mem_offset++;
-    val = env->device->adapter->read_mem(env->device->instance, addr);
-
-    /* Compare */
-    rc = runtime_test(env, val, test);
-    style = (rc == RC_OK) ? STYLE_OK : STYLE_ERR;
-
-    runtime_print(env, STYLE_NONE, "\t");
-    runtime_print_addr(env, STYLE_NONE, addr);
-    runtime_print(env, STYLE_NONE, "\t");
-    runtime_print_test(env, STYLE_NONE, test);
-    runtime_print(env, STYLE_NONE, "\t");
-    runtime_print_value(env, style, val);
-    runtime_print(env, STYLE_NONE, "\n");
+    *count = 0;
 
-    return STATE_MEMTEST_DATA;
-}
+    while (rc == RC_OK && fgets(line, BUF_LEN, f) != NULL) {
+        size_t len, i;
+        unsigned char sum = 0;
+        unsigned long rec_addr;
+        char * c = line;
 
-state_t runtime_handle_memtest_end(env_t * env, const char * tok, const char * buf) {
-    return runtime_handle_cmd(env, tok, buf);
-}
+        line_num++;
 
-state_t runtime_handle_reset(env_t * env, const char * tok, const char * buf) {
+        /* Skip blank lines */
+        while (isspace((unsigned char)*c)) {
+            c++;
+        }
 
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
-    }
+        if (*c == '\0') {
+            continue;
+        }
 
-    /* Reset intance */
-    env->device->adapter->reset(env->device->instance);
+        /* Decode record bytes */
+        if (*c++ != ':') {
+            runtime_error(env, "%s:%lu: Expected record start code", file, (unsigned long)line_num);
+            rc = RC_ERR;
+            break;
+        }
 
-    runtime_print(env, STYLE_CMD, "RESET\n");
+        for (len = 0; isxdigit((unsigned char)c[0]) && isxdigit((unsigned char)c[1]); len++) {
+            char byte[3];
 
-    return STATE_CMD;
-}
+            byte[0] = *c++;
+            byte[1] = *c++;
+            byte[2] = '\0';
 
-state_t runtime_handle_step(env_t * env, const char * tok, const char * buf) {
+            rec[len] = (unsigned char)strtoul(byte, NULL, 16);
+            sum += rec[len];
+        }
 
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
-    }
+        /* Validate record length and checksum */
+        if (len < 5 || len != (size_t)rec[0] + 5 || sum != 0) {
+            runtime_error(env, "%s:%lu: Malformed record", file, (unsigned long)line_num);
+            rc = RC_ERR;
+            break;
+        }
 
-    /* Step instance */
-    env->device->adapter->step(env->device->instance);
+        rec_addr = (unsigned long)rec[1] << 8 | rec[2];
 
-    runtime_print(env, STYLE_CMD, "STEP\n");
+        switch (rec[3]) {
+            case 0x00:
+                /* Data */
+                if (rec[0] % word_bytes != 0) {
+                    runtime_error(env, "%s:%lu: Partial word in data record",
+                                  file, (unsigned long)line_num);
+                    rc = RC_ERR;
+                    break;
+                }
 
-    return STATE_CMD;
-}
+                runtime_write_mem_block(env, addr + (base + rec_addr) / word_bytes,
+                                        &rec[4], rec[0] / word_bytes);
 
+                *count += rec[0] / word_bytes;
+                break;
+            case 0x01:
+                /* End of file */
+                fclose(f);
+                return RC_OK;
+            case 0x02:
+                /* Extended segment address */
+                for (i = 0, base = 0; i < rec[0]; i++) {
+                    base = base << 8 | rec[4 + i];
+                }
+
+                base <<= 4;
+                break;
+            case 0x04:
+                /* Extended linear address */
+                for (i = 0, base = 0; i < rec[0]; i++) {
+                    base = base << 8 | rec[4 + i];
+                }
 
-state_t runtime_handle_run(env_t * env, const char * tok, const char * buf) {
+                base <<= 16;
+                break;
+            case 0x03:
+            case 0x05:
+                /* Start address records have no effect on memory */
+                break;
+            default:
+                runtime_error(env, "%s:%lu: Unsupported record type %02X",
+                              file, (unsigned long)line_num, rec[3]);
+                rc = RC_ERR;
+                break;
+        }
+    }
 
-    /* Validate device */
-    if (env->device == NULL) {
-        runtime_error(env, "No device configured");
-        return STATE_ERR;
+    if (rc == RC_OK && ferror(f)) {
+        runtime_error(env, "Error reading file '%s': %s", file, strerror(errno));
+        rc = RC_ERR;
     }
 
-    return STATE_RUN_CYCLES;
+    fclose(f);
+
+    return rc;
 }
 
-state_t runtime_handle_run_cycles(env_t * env, const char * tok, const char * buf) {
-    value_t val;
-    unsigned int cycles;
-    clock_t start, elapsed;
-    double khz;
+rc_t runtime_parse_operand(env_t * env, const char * tok, test_t * test, size_t * var) {
+    char buf[BUF_LEN];
+    char * plus;
+    char * name;
+    char * literal;
 
-    /* Validate cycle count */
-    if (runtime_parse_value(env, tok, &val) == RC_OK) {
-        cycles = val.data;
-    } else {
-        runtime_error(env, "Expected cycle count, found '%s'\n", tok);
-        return STATE_ERR;
-    }
+    *var = 0;
 
-    /* Start run clock */
-    start = clock();
+    /* Plain literals */
+    if (runtime_parse_var(env, tok) != RC_OK && strchr(tok, '+') == NULL) {
+        return runtime_parse_test(env, tok, test);
+    }
 
-    /* Run instance */
-    env->device->adapter->run(env->device->instance, cycles);
+    /* Split into a variable and an optional literal offset, in either order */
+    strcpy(buf, tok);
 
-    /* Capture clock speed */
-    elapsed = clock() - start;
-    khz = .001 * CLOCKS_PER_SEC * cycles / elapsed;
+    name = buf;
+    literal = NULL;
 
-    runtime_print(env, STYLE_CMD, "RUN\t");
-    runtime_print(env, STYLE_NONE, "%zu\t@\t", cycles);
+    if ((plus = strchr(buf, '+')) != NULL) {
+        *plus = '\0';
+        literal = plus + 1;
 
-    if (khz > 1000) {
-        runtime_print(env, STYLE_INFO, "%.3f MHz\n", khz / 1000);
-    } else {
-        runtime_print(env, STYLE_INFO, "%.3f kHz\n", khz);
+        if (runtime_parse_var(env, name) != RC_OK) {
+            name = plus + 1;
+            literal = buf;
+        }
     }
 
-    return STATE_CMD;
-}
+    if (runtime_parse_var(env, name) != RC_OK) {
+        return RC_ERR;
+    }
 
-rc_t runtime_test(env_t * env, value_t val, test_t test) {
-    if (test.data == (val.data & test.mask)) {
-        return RC_OK;
-    } else {
-        env->success = RC_ERR;
+    if ((*var = runtime_prog_var(env, name, 0)) == 0) {
+        runtime_error(env, "Undefined variable '%s'", name);
+        return RC_ERR;
+    }
 
+    /* Offsets must be exact, and set the display format of the result */
+    if (literal == NULL) {
+        test->data = 0;
+        test->mask = -1;
+        test->bits = 0;
+        test->base = 10;
+    } else if (runtime_parse_test(env, literal, test) != RC_OK || ~test->mask) {
         return RC_ERR;
     }
+
+    return RC_OK;
 }
 
-rc_t runtime_parse_value(const env_t * env, const char * tok, value_t * value) {
-    test_t test;
+rc_t runtime_parse_var(const env_t * env, const char * tok) {
+    const char * c;
 
-    if (runtime_parse_test(env, tok, &test) != RC_OK) {
+    /* Names start with a letter and must not be confused with don't-care values */
+    if (!isalpha((unsigned char)tok[0]) || strcmp(tok, "x") == 0 || strcmp(tok, "X") == 0) {
         return RC_ERR;
     }
 
-    if (~test.mask) {
+    if (strlen(tok) >= VAR_LEN) {
         return RC_ERR;
     }
 
-    value->data = test.data;
-    value->bits = test.bits;
-    value->base = test.base;
+    for (c = tok; *c; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') {
+            return RC_ERR;
+        }
+    }
 
     return RC_OK;
 }
@@ -1364,13 +2623,294 @@ void runtime_device_destroy(device_t * device) {
     free(device);
 }
 
-env_t * runtime_env_init(const char * file) {
+
+prog_t * runtime_prog_init(void) {
+    prog_t * prog = malloc(sizeof(prog_t));
+
+    prog->instrs_size = 64;
+    prog->instrs = malloc(sizeof(instr_t) * prog->instrs_size);
+    prog->instrs_count = 0;
+
+    prog->args_size = BUF_LEN;
+    prog->args = malloc(sizeof(arg_t) * prog->args_size);
+    prog->args_count = 0;
+
+    prog->strs_size = BUF_LEN;
+    prog->strs = malloc(sizeof(char) * prog->strs_size);
+    prog->strs_len = 0;
+
+    prog->vars_size = 16;
+    prog->vars = malloc(sizeof(char) * prog->vars_size * VAR_LEN);
+    prog->vals = malloc(sizeof(unsigned int) * prog->vars_size);
+    prog->vars_count = 0;
+
+    prog->blocks_count = 0;
+
+    return prog;
+}
+
+void runtime_prog_destroy(prog_t * prog) {
+    free(prog->instrs);
+    free(prog->args);
+    free(prog->strs);
+    free(prog->vars);
+    free(prog->vals);
+
+    free(prog);
+}
+
+void runtime_prog_reset(prog_t * prog) {
+
+    /* Keep variables so later commands in the shell can refer to them */
+    prog->instrs_count = 0;
+    prog->args_count = 0;
+    prog->strs_len = 0;
+    prog->blocks_count = 0;
+}
+
+instr_t * runtime_prog_begin(env_t * env, op_t op) {
+    prog_t * prog = env->prog;
+    instr_t * instr;
+
+    /* Reserve space for the instruction, which is only counted once committed */
+    if (prog->instrs_count == prog->instrs_size) {
+        prog->instrs_size *= 2;
+        prog->instrs = realloc(prog->instrs, sizeof(instr_t) * prog->instrs_size);
+    }
+
+    instr = &prog->instrs[prog->instrs_count];
+
+    memset(instr, 0, sizeof(instr_t));
+    instr->op = op;
+    instr->line = env->line;
+    instr->args = prog->args_count;
+
+    return instr;
+}
+
+instr_t * runtime_prog_instr(env_t * env) {
+    return &env->prog->instrs[env->prog->instrs_count];
+}
+
+void runtime_prog_commit(env_t * env) {
+    env->prog->instrs_count++;
+}
+
+arg_t * runtime_prog_arg(env_t * env) {
+    prog_t * prog = env->prog;
+    arg_t * arg;
+
+    /* Append an operand to the instruction being compiled */
+    if (prog->args_count == prog->args_size) {
+        prog->args_size *= 2;
+        prog->args = realloc(prog->args, sizeof(arg_t) * prog->args_size);
+    }
+
+    arg = &prog->args[prog->args_count++];
+    memset(arg, 0, sizeof(arg_t));
+
+    runtime_prog_instr(env)->args_count++;
+
+    return arg;
+}
+
+size_t runtime_prog_str(env_t * env, const char * str) {
+    prog_t * prog = env->prog;
+    size_t len = strlen(str) + 1;
+    size_t offset = prog->strs_len;
+
+    /* Append a null terminated string to the string pool */
+    while (prog->strs_len + len > prog->strs_size) {
+        prog->strs_size *= 2;
+        prog->strs = realloc(prog->strs, sizeof(char) * prog->strs_size);
+    }
+
+    memcpy(&prog->strs[offset], str, len);
+    prog->strs_len += len;
+
+    return offset;
+}
+
+size_t runtime_prog_var(env_t * env, const char * name, int define) {
+    prog_t * prog = env->prog;
+    size_t v;
+
+    /* Look up named variables, unnamed ones are always new */
+    if (name != NULL) {
+        for (v = 0; v < prog->vars_count; v++) {
+            if (strcmp(&prog->vars[v * VAR_LEN], name) == 0) {
+                return v + 1;
+            }
+        }
+    }
+
+    if (!define) {
+        return 0;
+    }
+
+    /* Define variable */
+    if (prog->vars_count == prog->vars_size) {
+        prog->vars_size *= 2;
+        prog->vars = realloc(prog->vars, sizeof(char) * prog->vars_size * VAR_LEN);
+        prog->vals = realloc(prog->vals, sizeof(unsigned int) * prog->vars_size);
+    }
+
+    strcpy(&prog->vars[prog->vars_count * VAR_LEN], name != NULL ? name : "");
+    prog->vals[prog->vars_count] = 0;
+
+    return ++prog->vars_count;
+}
+
+prog_t * runtime_cache_read(const char * file) {
+    char cache_file[BUF_LEN];
+    cache_header_t header;
+    cache_header_t stamp;
+    prog_t * prog;
+    FILE * f;
+
+    /* Look up the current version of the source */
+    if (runtime_cache_stamp(file, &stamp) != RC_OK) {
+        return NULL;
+    }
+
+    /* Open cache file for reading */
+    sprintf(cache_file, "%s%s", file, CACHE_SUFFIX);
+
+    f = fopen(cache_file, "rb");
+
+    if (f == NULL) {
+        return NULL;
+    }
+
+    /* Validate header against the source and this build of the runtime */
+    if (fread(&header, sizeof(cache_header_t), 1, f) != 1
+            || memcmp(header.magic, stamp.magic, sizeof(header.magic)) != 0
+            || header.version != stamp.version
+            || header.instr_size != stamp.instr_size
+            || header.arg_size != stamp.arg_size
+            || header.source_hash != stamp.source_hash
+            || header.source_size != stamp.source_size) {
+        fclose(f);
+        return NULL;
+    }
+
+    /* Read program */
+    prog = malloc(sizeof(prog_t));
+
+    prog->instrs_count = prog->instrs_size = header.instrs_count;
+    prog->args_count = prog->args_size = header.args_count;
+    prog->strs_len = prog->strs_size = header.strs_len;
+    prog->vars_count = prog->vars_size = header.vars_count;
+    prog->blocks_count = 0;
+
+    prog->instrs = malloc(sizeof(instr_t) * prog->instrs_size + 1);
+    prog->args = malloc(sizeof(arg_t) * prog->args_size + 1);
+    prog->strs = malloc(sizeof(char) * prog->strs_size + 1);
+
+    /* Names are not cached since they are only needed to compile */
+    prog->vars = calloc(prog->vars_size + 1, sizeof(char) * VAR_LEN);
+    prog->vals = calloc(prog->vars_size + 1, sizeof(unsigned int));
+
+    if (fread(prog->instrs, sizeof(instr_t), prog->instrs_count, f) != prog->instrs_count
+            || fread(prog->args, sizeof(arg_t), prog->args_count, f) != prog->args_count
+            || fread(prog->strs, sizeof(char), prog->strs_len, f) != prog->strs_len) {
+        runtime_prog_destroy(prog);
+        fclose(f);
+        return NULL;
+    }
+
+    fclose(f);
+
+    return prog;
+}
+
+void runtime_cache_write(const char * file, const prog_t * prog) {
+    char cache_file[BUF_LEN];
+    cache_header_t header;
+    FILE * f;
+
+    if (runtime_cache_stamp(file, &header) != RC_OK) {
+        return;
+    }
+
+    header.instrs_count = prog->instrs_count;
+    header.args_count = prog->args_count;
+    header.strs_len = prog->strs_len;
+    header.vars_count = prog->vars_count;
+
+    /* Open cache file for writing, the cache is best effort so errors are ignored */
+    sprintf(cache_file, "%s%s", file, CACHE_SUFFIX);
+
+    f = fopen(cache_file, "wb");
+
+    if (f == NULL) {
+        return;
+    }
+
+    if (fwrite(&header, sizeof(cache_header_t), 1, f) != 1
+            || fwrite(prog->instrs, sizeof(instr_t), prog->instrs_count, f) != prog->instrs_count
+            || fwrite(prog->args, sizeof(arg_t), prog->args_count, f) != prog->args_count
+            || fwrite(prog->strs, sizeof(char), prog->strs_len, f) != prog->strs_len) {
+        fclose(f);
+        remove(cache_file);
+        return;
+    }
+
+    fclose(f);
+}
+
+rc_t runtime_cache_stamp(const char * file, cache_header_t * header) {
+    unsigned char buf[BUF_LEN];
+    unsigned long hash = 2166136261UL;
+    long size = 0;
+    size_t len, i;
+
+    /* Hash the source with 32-bit FNV-1a, so a cache only matches the contents it was compiled from */
+    FILE * f = fopen(file, "rb");
+
+    if (f == NULL) {
+        return RC_ERR;
+    }
+
+    while ((len = fread(buf, 1, BUF_LEN, f)) > 0) {
+        for (i = 0; i < len; i++) {
+            hash = ((hash ^ buf[i]) * 16777619UL) & 0xFFFFFFFFUL;
+        }
+
+        size += (long)len;
+    }
+
+    if (ferror(f)) {
+        fclose(f);
+        return RC_ERR;
+    }
+
+    fclose(f);
+
+    /* Clear padding so headers can be written and compared as raw bytes */
+    memset(header, 0, sizeof(cache_header_t));
+
+    memcpy(header->magic, CACHE_MAGIC, sizeof(header->magic));
+    header->version = CACHE_VERSION;
+    header->instr_size = sizeof(instr_t);
+    header->arg_size = sizeof(arg_t);
+    header->source_hash = hash;
+    header->source_size = size;
+
+    return RC_OK;
+}
+
+env_t * runtime_env_init(const char * file, int cache) {
     env_t * env = malloc(sizeof(env_t));
 
     /* Initialize runtime */
     env->file = file;
-    env->line = 1;
+    env->line = 0;
     env->success = RC_OK;
+    env->cache = cache;
+
+    /* Initialize program being compiled */
+    env->prog = NULL;
 
     /* Initialize device emulator */
     env->device = NULL;
@@ -1378,13 +2918,8 @@ env_t * runtime_env_init(const char * file) {
     /* Initialize pins */
     env->pins = malloc(sizeof(char *) * MAX_PINS);
     env->pins_buf = malloc(sizeof(char) * MAX_PINS * PIN_LEN);
+    env->pin_handles = malloc(sizeof(int) * MAX_PINS);
     env->pins_count = 0;
-    env->pin_tests = malloc(sizeof(test_t) * MAX_PINS);
-    env->pin_tests_count = 0;
-
-    /* Initialize memory */
-    env->mem_addr = 0;
-    env->mem_offset = 0;
 
     return env;
 }
@@ -1399,7 +2934,7 @@ void runtime_env_destroy(env_t * env) {
     /* Clean up runtime */
     free(env->pins);
     free(env->pins_buf);
-    free(env->pin_tests);
+    free(env->pin_handles);
 
     free(env);
 }
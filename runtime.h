@@ -31,6 +31,22 @@ typedef struct {
     void (* write_pin)(void * instance, const char * pin, unsigned int data);
     value_t (* read_mem)(const void * instance, unsigned int addr);
     void (* write_mem)(void * instance, unsigned int addr, unsigned int data);
+
+    /* Block functions (words are packed least significant byte first), or NULL to fall back to
+       read_mem/write_mem */
+    void (* read_mem_block)(const void * instance, unsigned int addr,
+                            unsigned char * data, size_t count);
+    void (* write_mem_block)(void * instance, unsigned int addr,
+                             const unsigned char * data, size_t count);
+
+    /* Direct access to packed memory at an address, or NULL if not supported */
+    const unsigned char * (* get_mem)(const void * instance, unsigned int addr, size_t * count);
+
+    /* Pin handle functions (resolve_pin returns -1 for unknown pins), or NULL to fall back to
+       read_pin/write_pin */
+    int (* resolve_pin)(const void * instance, const char * pin);
+    value_t (* read_pin_handle)(const void * instance, int pin);
+    void (* write_pin_handle)(void * instance, int pin, unsigned int data);
 } adapter_t;
 
 /* --- Function types --- */